@@ -165,6 +165,11 @@ public dec64_signum;(number: dec64)
 public dec64_subtract;(minuend: dec64, subtrahend: dec64)
 ;   returns difference: dec64
 
+public dec64_stats;(path: int64)
+;   returns count: int64
+
+public dec64_stats_reset;()
+
 ;  -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
 ; Repair the register names. Over the long and twisted evolution of x86, the
@@ -177,6 +182,7 @@ public dec64_subtract;(minuend: dec64, subtrahend: dec64)
 r0      equ rax
 r1      equ rcx
 r2      equ rdx
+r4      equ rsp
 r6      equ rsi
 r7      equ rdi
 
@@ -204,8 +210,15 @@ r1_w    equ cx
 ; two arguments are passed in r7 and r6. We try to hide this behind macros. The
 ; two systems also have different conventions about which registers may be
 ; clobbered and which must be preserved. This code lives in the intersection.
+;
+; UNIX, STATS, and SYMBOLS can also be set on the command line, so that every
+; configuration can be built from the same file:
+;
+;     ml64 /c /DUNIX=1 /DSTATS=1 dec64.asm
 
+    ifndef UNIX
 UNIX    equ 0                   ; calling convention: 0 for Windows, 1 for Unix
+    endif
 
 function_with_one_parameter macro
     if UNIX
@@ -250,6 +263,100 @@ tail_with_two_parameters macro function
     jmp     function
     endm
 
+; An instrumented build counts the entries into the slow paths, so that we can
+; see which paths a workload actually takes. Set STATS to 1 to count. When it
+; is 0, count expands to nothing and dec64_stats always returns 0. The path
+; numbers must agree with the DEC64_STATS_ constants in dec64.h. pack_large
+; loops back through pack, so its count is of iterations, one for each digit
+; that it removes, rather than of entries.
+
+    ifndef STATS
+STATS   equ 0                   ; path counting: 0 for off, 1 for on
+    endif
+
+stats_add_overflow          equ 0
+stats_add_slow              equ 1
+stats_add_slower            equ 2
+stats_pack_large            equ 3
+stats_pack_increase         equ 4
+stats_divide_prescale       equ 5
+stats_normal_divide         equ 6
+stats_integer_divide_slow   equ 7
+stats_modulo_slow           equ 8
+stats_less_slow             equ 9
+stats_nr_paths              equ 10
+
+; The increment changes the flags, so count is only placed where the flags are
+; dead, where the next instruction to test a flag follows one that sets it. It
+; does not save them with pushfq, because that would move the stack pointer in
+; the middle of a block, where no unwind information could describe it.
+
+count macro path
+    if STATS
+    lock inc qword ptr stats[path * 8] ;; STATS
+    endif
+    endm
+
+; A profiler attributes each sample to the nearest symbol. Normally the only
+; symbols are the public functions, so time spent in pack or add_slow is charged
+; to whichever function precedes it. Set SYMBOLS to 1 to make every block of
+; code a proc, so that it gets its own symbol with a size. The public functions
+; begin with public_block, and every other block is private, so that nothing
+; else is exported. The blocks fall and jump into each other freely, so labels
+; are not scoped to their procs.
+;
+; A block that moves the stack pointer begins with frame_block instead. It is a
+; proc frame whether or not SYMBOLS is set, and its prolog declares its pushes,
+; so that the assembler writes the unwind information that lets a profiler or
+; a debugger find the caller from within the functions that it calls. Only
+; modulo_slow needs that. The other blocks leave the stack pointer alone, so
+; their return address is always at the top of the stack.
+
+    ifndef SYMBOLS
+SYMBOLS equ 0                   ; sized symbols: 0 for off, 1 for on
+    endif
+
+    option noscoped
+
+in_block = 0
+
+open_block macro label_name, visibility, frame
+    if in_block
+current_block endp
+in_block = 0
+    endif
+    ifnb <frame>
+label_name proc visibility frame
+current_block textequ <label_name>
+in_block = 1
+    elseif SYMBOLS
+label_name proc visibility
+current_block textequ <label_name>
+in_block = 1
+    else
+label_name:
+    endif
+    endm
+
+block macro label_name
+    open_block label_name, private
+    endm
+
+public_block macro label_name
+    open_block label_name, public
+    endm
+
+frame_block macro label_name
+    open_block label_name, private, frame
+    endm
+
+block_end macro
+    if in_block
+current_block endp
+in_block = 0
+    endif
+    endm
+
 ; There may be a performance benefit in padding programs so that most jump
 ; destinations are aligned on 16 byte boundaries.
 
@@ -286,11 +393,20 @@ power:                              ; the powers of 10
 
 dec64_data ends
 
+dec64_stats_data segment para read write
+
+stats:                              ; the slow path counts
+
+    qword   stats_nr_paths dup (0)
+
+dec64_stats_data ends
+
 ;  -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
 dec64_code segment para execute
 
-dec64_coefficient: function_with_one_parameter
+public_block dec64_coefficient
+    function_with_one_parameter
 ;(number: dec64) returns coefficient: int64
 
 ; Return the coefficient part from a dec64 number.
@@ -301,7 +417,8 @@ dec64_coefficient: function_with_one_parameter
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_exponent: function_with_one_parameter
+public_block dec64_exponent
+    function_with_one_parameter
 ;(number: dec64) returns exponent: int64
 
 ; Return the exponent part, sign extended to 64 bits, from a dec64 number.
@@ -312,7 +429,8 @@ dec64_exponent: function_with_one_parameter
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_new: function_with_two_parameters
+public_block dec64_new
+    function_with_two_parameters
 ;(coefficient: int64, exponent: int64) returns number: dec64
 
 ; Construct a new dec64 number with a coefficient and an exponent.
@@ -326,7 +444,7 @@ dec64_new: function_with_two_parameters
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-pack:
+block   pack
 
 ; The pack function combines the coefficient and exponent into a dec64.
 ; Numbers that are too huge to be contained in this format become nan.
@@ -373,8 +491,9 @@ pack:
     ret                             ; whew
     pad
 
-pack_large:
+block   pack_large
 
+    count   stats_pack_large
     mov     r1, r0                  ; r1 is the coefficient
     sar     r1, 63                  ; r1 is -1 if negative, or 0 if positive
     mov     r11, eight_over_ten     ; magic number
@@ -391,8 +510,9 @@ pack_large:
     jmp     pack                    ; start over
     pad
 
-pack_increase:
+block   pack_increase
 
+    count   stats_pack_increase
     mov     r10, power
     mov     r10, [r10][r9*8]        ; r10 is 10^r9
     cmp     r9, 20                  ; is the difference more than 20?
@@ -409,7 +529,7 @@ pack_increase:
     jmp     pack                    ; start over
     pad
 
-pack_decrease:
+block   pack_decrease
 
 ; The exponent is too big. We can attempt to reduce it by scaling back.
 ; This can salvage values in a small set of cases.
@@ -431,7 +551,8 @@ pack_decrease:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_round: function_with_two_parameters
+public_block dec64_round
+    function_with_two_parameters
 ;(number: dec64, place: dec64) returns quantization: dec64
 
 ; The place argument indicates at what decimal place to round.
@@ -445,7 +566,7 @@ dec64_round: function_with_two_parameters
 
     pad
 
-round_begin:
+block   round_begin
 
     cmp     r1_b, 128               ; is the number nan?
     jz      return_null
@@ -466,7 +587,7 @@ round_begin:
     cmovns  r0, r1                  ; r0 is abs(coefficient)
     pad
 
-round_loop:
+block   round_loop
 
 ; Increment the exponent and divide the coefficient by 10 until the target
 ; exponent is reached. The division is accomplished by multiplying with a
@@ -491,7 +612,7 @@ round_loop:
     jmp     pack                    ; pack it up
     pad
 
-round_places:
+block   round_places
 
 ; Places does not seem to be an integer. If it is nan, then default to zero.
 
@@ -501,7 +622,7 @@ round_places:
     jmp     round_begin
     pad
 
-round_normal:
+block   round_normal
 
     mov     r10, r1                 ; save the number
     mov     r1, r2                  ; pass the place
@@ -514,7 +635,8 @@ round_normal:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_dec: function_with_one_parameter
+public_block dec64_dec
+    function_with_one_parameter
 ;(number: dec64) returns difference: dec64
 
 ; Subtract 1 from a dec64 number. This is a special case for fast integers.
@@ -526,7 +648,7 @@ dec64_dec: function_with_one_parameter
     jo      add_overflow            ; deal with the overflow
     ret                             ; we are done
 
-dec_slow:
+block   dec_slow
 
 ; The exponent is not zero, or the incrementation overflowed. So just jump to
 ; add_slower. There are more optimizations available (like subtracting a power)
@@ -538,7 +660,8 @@ dec_slow:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_inc: function_with_one_parameter
+public_block dec64_inc
+    function_with_one_parameter
 ;(number: dec64) returns sum: dec64
 
 ; Add 1 to a dec64 number. This is a special case for fast integers.
@@ -550,7 +673,7 @@ dec64_inc: function_with_one_parameter
     jo      add_overflow            ; deal with overflow
     ret                             ; it is done
 
-inc_slow:
+block   inc_slow
 
 ; The exponent is not zero. So just jump to add_slower. There are more
 ; optimizations available (like adding a power) but it is not worth it.
@@ -561,7 +684,8 @@ inc_slow:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_add: function_with_two_parameters
+public_block dec64_add
+    function_with_two_parameters
 ;(augend: dec64, addend: dec64) returns sum: dec64
 
 ; Add two dec64 numbers together.
@@ -572,7 +696,7 @@ dec64_add: function_with_two_parameters
 
     pad
 
-add_begin:
+block   add_begin
 
     mov     r0, r1                  ; r0 is the first number
     or      r1_b, r2_b              ; r1_b is the two exponents or'd together
@@ -582,19 +706,21 @@ add_begin:
     ret                             ; no need to pack
     pad
 
-add_overflow:
+block   add_overflow
 
 ; If there was an overflow (extremely unlikely) then we must make it fit.
 ; pack knows how to do that.
 
     rcr     r0, 1                   ; divide the sum by 2 and repair its sign
+    count   stats_add_overflow      ; after rcr, which needs the carry
     movsx   r8, r1_b                ; r8 is the exponent
     sar     r0, 7                   ; r0 is the coefficient of the sum
     jmp     pack                    ; pack it up
     pad
 
-add_slow:
+block   add_slow
 
+    count   stats_add_slow
 ; The slow path is taken if the two operands do not both have zero exponents.
 
     mov     r1, r0                  ; restore r1
@@ -621,8 +747,9 @@ add_slow:
     ret                             ; no need to pack
     pad
 
-add_slower:
+block   add_slower
 
+    count   stats_add_slower
 ; The slower path is taken when neither operand is nan, and their
 ; exponents are different. Before addition can take place, the exponents
 ; must be made to match. Swap the numbers if the second exponent is greater
@@ -648,7 +775,7 @@ add_slower:
     mov     r0, r10                 ; r0 is the first coefficient
     pad
 
-add_slower_decrease:
+block   add_slower_decrease
 
 ; The coefficients are not the same. Before we can add, they must be the same.
 ; We try to decrease the first exponent. When we decrease the exponent
@@ -667,10 +794,11 @@ add_slower_decrease:
 ; The exponents are now equal, so the coefficients may be added.
 
     add     r0, r10                 ; add the two coefficients
+    jo      add_slower_overflow     ; if it overflows, it must be repaired
     jmp     pack                    ; pack it up
     pad
 
-add_slower_increase:
+block   add_slower_increase
 
 ; We cannot decrease the first exponent any more, so we must instead try to
 ; increase the second exponent, which results in a loss of significance.
@@ -694,15 +822,38 @@ add_slower_increase:
 ; The exponents are now equal, so the coefficients may be added.
 
     add     r0, r10                 ; add the two coefficients
+    jo      add_slower_overflow     ; if it overflows, it must be repaired
     jmp     pack
     pad
 
-return_r1:
+block   add_slower_overflow
+
+; The coefficients were scaled to fill a register, so their sum can overflow.
+; The sum is the opposite sign of what r0 now shows, and its magnitude still
+; fits in 64 unsigned bits. Take a tenth of the magnitude, as pack_large does,
+; so that the truncation is toward zero for both signs, and restore the sign.
+
+    mov     r1, r0                  ; r1 is the wrapped sum
+    sar     r1, 63                  ; r1 is -1 if the true sum is positive
+    not     r1                      ; r1 is -1 if the true sum is negative
+    xor     r0, r1                  ; complement the sum if negative
+    sub     r0, r1                  ; r0 is the magnitude of the sum (unsigned)
+    mov     r11, eight_over_ten     ; magic number
+    mul     r11                     ; multiply the magnitude by magic number
+    mov     r0, r2                  ; r0 is the product shift 64 bits
+    shr     r0, 3                   ; r0 is divided by 8: magnitude / 10
+    xor     r0, r1                  ; complement the tenth if negative
+    sub     r0, r1                  ; r0 is a tenth of the sum, with its sign
+    add     r8, 1                   ; increase the exponent
+    jmp     pack                    ; pack it up
+    pad
+
+block   return_r1
 
     mov     r0, r1
     ret
 
-return_r2:
+block   return_r2
 
     mov     r0, r2
     sar     r11, 8                  ; r11 is the second coefficient
@@ -711,7 +862,8 @@ return_r2:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_ceiling: function_with_one_parameter
+public_block dec64_ceiling
+    function_with_one_parameter
 ;(number: dec64) returns integer: dec64
 
 ; Produce the smallest integer that is greater than or equal to the number. In
@@ -726,7 +878,8 @@ dec64_ceiling: function_with_one_parameter
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_floor: function_with_one_parameter
+public_block dec64_floor
+    function_with_one_parameter
 ;(number: dec64) returns integer: dec64
 
 ; Produce the largest integer that is less than or equal to the number. This
@@ -740,7 +893,7 @@ dec64_floor: function_with_one_parameter
     mov     r9, -1                  ; r9 is the round down flag
     pad
 
-floor_begin:
+block   floor_begin
 
     cmp     r1_b, 128
     je      return_null
@@ -763,13 +916,13 @@ floor_begin:
     ret
     pad
 
-floor_micro:
+block   floor_micro
 
     mov     r2, r0                  ; r2 is the coefficient
     xor     r0, r0                  ; r0 is zero
     pad
 
-floor_remains:
+block   floor_remains
 
 ; If the remainder is negative and the rounding flag is negative, then we need
 ; to decrement r0. But if the remainder and the rounding flag are both
@@ -784,7 +937,8 @@ floor_remains:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_subtract: function_with_two_parameters
+public_block dec64_subtract
+    function_with_two_parameters
 ;(minuend: dec64, subtrahend: dec64) returns difference: dec64
 
 ; Subtract the dec64 number in r2 from the dec64 number in r1.
@@ -820,7 +974,7 @@ dec64_subtract: function_with_two_parameters
     jmp     subtract_slower_decrease_compare
     pad
 
-subtract_slower_decrease:
+block   subtract_slower_decrease
 
 ; The coefficients are not the same. Before we can add, they must be the same.
 ; We try to decrease the first exponent. When we decrease the exponent
@@ -834,7 +988,7 @@ subtract_slower_decrease:
     mov     r10, r0                 ; r10 is the enlarged first coefficient
     pad
 
-subtract_slower_decrease_compare:
+block   subtract_slower_decrease_compare
 
     cmp     r8, r9                  ; are the exponents equal yet?
     jg      subtract_slower_decrease
@@ -843,10 +997,11 @@ subtract_slower_decrease_compare:
 ; The exponents are now equal, so the coefficients may be added.
 
     add     r0, r10                 ; add the two coefficients
+    jo      add_slower_overflow     ; if it overflows, it must be repaired
     jmp     pack                    ; pack it up
     pad
 
-subtract_slower_increase:
+block   subtract_slower_increase
 
 ; We cannot decrease the first exponent any more, so we must instead try to
 ; increase the second exponent, which results in a loss of significance.
@@ -868,17 +1023,19 @@ subtract_slower_increase:
 ; The exponents are now equal, so the coefficients may be added.
 
     add     r0, r10                 ; add the two coefficients
+    jo      add_slower_overflow     ; if it overflows, it must be repaired
     jmp     pack
     pad
 
-subtract_underflow:
+block   subtract_underflow
 
     mov     r0, r10                 ; r0 is the first coefficient
     jmp     pack
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_multiply: function_with_two_parameters
+public_block dec64_multiply
+    function_with_two_parameters
 ;(multiplicand: dec64, multiplier: dec64) returns product: dec64
 
 ; Multiply two dec64 numbers together.
@@ -938,7 +1095,8 @@ dec64_multiply: function_with_two_parameters
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_divide: function_with_two_parameters
+public_block dec64_divide
+    function_with_two_parameters
 ;(dividend: dec64, divisor: dec64) returns quotient: dec64
 
 ; Divide a dec64 number by another.
@@ -971,7 +1129,7 @@ dec64_divide: function_with_two_parameters
     sub     r8, r9                  ; r8 is the quotient exponent
     pad
 
-divide_measure:
+block   divide_measure
 
 ; We want to get as many bits into the quotient as possible in order to capture
 ; enough significance. But if the quotient has more than 64 bits, then there
@@ -1015,8 +1173,9 @@ divide_measure:
     jmp     pack                    ; pack it up
     pad
 
-divide_prescale:
+block   divide_prescale
 
+    count   stats_divide_prescale
 ; If the number of scaling digits is larger than 18, then we have to
 ; scale in two steps: first prescaling the dividend to fill a register, and
 ; then repeating to fill a second register. This happens when the divisor
@@ -1031,7 +1190,7 @@ divide_prescale:
     sub     r8, r1                  ; reduce the exponent
     jmp     divide_measure          ; try again
 
-divide_two:
+block   divide_two
 
 ; Divide a dec64 number by two.
 
@@ -1049,7 +1208,7 @@ divide_two:
     jmp     pack
     pad
 
-divide_half:
+block   divide_half
 
 ; If the least significant bit of the coefficient is 0, then we can do this
 ; the fast way. Shift the coefficient by 1 bit and restore the exponent. If
@@ -1065,7 +1224,8 @@ divide_half:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_integer_divide: function_with_two_parameters
+public_block dec64_integer_divide
+    function_with_two_parameters
 ;(dividend: dec64, divisor: dec64) returns quotient: dec64
 
 ; Divide, with a floored integer result. It produces the same result as
@@ -1088,14 +1248,26 @@ dec64_integer_divide: function_with_two_parameters
     setz    r2_h                    ; r2_h is 1 if divisor coefficient is zero
     or      r2_b, r2_h              ; r2_b is 1 if the result is nan
     jnz     return_null
+    cmp     r11, -1                 ; is the divisor coefficient -1?
+    je      integer_divide_negate
     cqo                             ; sign extend r0 into r2
     idiv    r11                     ; r0 is the quotient
     and     r0, -256                ; zero the exponent again
     ret                             ; no need to pack
     pad
 
-integer_divide_slow:
+block   integer_divide_negate
+
+; Dividing the smallest coefficient by -1 would fault in idiv, so negate the
+; dividend instead. Its exponent has already been zeroed.
+
+    mov     r1, r0
+    tail_with_one_parameter dec64_neg
+    pad
+
+block   integer_divide_slow
 
+    count   stats_integer_divide_slow
 ; The exponents are not the same, so do it the hard way.
 
     call_with_two_parameters dec64_divide
@@ -1104,7 +1276,8 @@ integer_divide_slow:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_modulo: function_with_two_parameters
+public_block dec64_modulo
+    function_with_two_parameters
 ;(dividend: dec64, divisor: dec64) returns modulus: dec64
 
 ; Modulo. It produces the same result as
@@ -1149,24 +1322,32 @@ dec64_modulo: function_with_two_parameters
     ret
     pad
 
-modulo_slow:
+frame_block modulo_slow
 
-; The exponents are not the same, so do it the hard way.
+; The exponents are not the same, so do it the hard way. The operands are kept
+; on the stack across the calls. The stack pointer does not move again until
+; the epilog, so that the unwind information holds for the whole body.
 
     push    r1                      ; save the dividend
+    .pushreg r1
     push    r2                      ; save the divisor
+    .pushreg r2
+    .endprolog
 
+    count   stats_modulo_slow
     call_with_two_parameters dec64_integer_divide
-    pop     r2
-    mov     r1, r0
+    mov     r1, r0                  ; r1 is the quotient
+    mov     r2, [r4]                ; r2 is the divisor
     call_with_two_parameters dec64_multiply
-    pop     r1
-    mov     r2, r0
+    mov     r2, r0                  ; r2 is the product
+    mov     r1, [r4 + 8]            ; r1 is the dividend
+    add     r4, 16                  ; the epilog
     tail_with_two_parameters dec64_subtract
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_signum: function_with_one_parameter
+public_block dec64_signum
+    function_with_one_parameter
 ;(number: dec64) returns signature: dec64
 
 ; If the number is nan, the result is nan.
@@ -1188,7 +1369,8 @@ dec64_signum: function_with_one_parameter
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_neg: function_with_one_parameter
+public_block dec64_neg
+    function_with_one_parameter
 ;(number: dec64) returns negation: dec64
 
 ; Negate a number. We need to negate the coefficient without changing the
@@ -1205,7 +1387,7 @@ dec64_neg: function_with_one_parameter
     jo      neg_overflow            ; nice day if it don't overflow
     ret
 
-neg_overflow:
+block   neg_overflow
 
 ; The coefficient is -36028797018963968, which is the only coefficient that
 ; cannot be trivially negated. So we do this the hard way.
@@ -1217,7 +1399,8 @@ neg_overflow:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_abs: function_with_one_parameter
+public_block dec64_abs
+    function_with_one_parameter
 ;(number: dec64) returns absolution: dec64
 
 ; Find the absolute value of a number. If the number is negative, hand it off
@@ -1234,7 +1417,8 @@ dec64_abs: function_with_one_parameter
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_equal: function_with_two_parameters
+public_block dec64_is_equal
+    function_with_two_parameters
 ;(comparahend: dec64, comparator: dec64) returns comparison: dec64
 
 ; Compare two dec64 numbers. If they are equal, return 1, otherwise return 0.
@@ -1270,7 +1454,8 @@ dec64_is_equal: function_with_two_parameters
     jmp     return_false
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_normal: function_with_one_parameter
+public_block dec64_normal
+    function_with_one_parameter
 ;(number: dec64) returns normalization: dec64
 
 ; Make the exponent as close to zero as possible without losing any signficance.
@@ -1291,9 +1476,10 @@ dec64_normal: function_with_one_parameter
     jns     normal_multiply         ; if the exponent is positive
     sar     r0, 8                   ; r0 is the coefficient
     sar     r9, 8                   ; r9 is the coefficient
+    count   stats_normal_divide     ; count the entry, not the iterations
     pad
 
-normal_divide:
+block   normal_divide
 
 ; While the exponent is less than zero, divide the coefficient by 10 and
 ; increment the exponent.
@@ -1307,7 +1493,7 @@ normal_divide:
     jnz     normal_divide           ; until the exponent is zero
     pad
 
-normal_divide_done:
+block   normal_divide_done
 
     mov     r0, r9                  ; r0 is the finished coefficient
     shl     r0, 8                   ; put it in position
@@ -1315,7 +1501,7 @@ normal_divide_done:
     ret
     pad
 
-normal_multiply:
+block   normal_multiply
 
 ; While the exponent is greater than zero, multiply the coefficient by 10 and
 ; decrement the exponent. If the coefficient gets too large, wrap it up.
@@ -1328,7 +1514,7 @@ normal_multiply:
     ret
     pad
 
-normal_multiply_done:
+block   normal_multiply_done
 
     mov     r0, r9                  ; r0 is the finished positioned coefficient
     mov     r0_b, r1_b              ; mix in the exponent
@@ -1336,7 +1522,7 @@ normal_multiply_done:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-return:
+block   return
 
 ; Return whatever is in r0.
 
@@ -1344,7 +1530,7 @@ return:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-return_null:
+block   return_null
 
 ; All of the dec64_ functions return only this form of nan.
 
@@ -1353,21 +1539,22 @@ return_null:
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-return_one:
+block   return_one
 
     mov     r0, 0100h               ; one
     ret
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-return_zero:
+block   return_zero
 
     xor     r0, r0                  ; zero
     ret
 
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_less: function_with_two_parameters
+public_block dec64_is_less
+    function_with_two_parameters
 ;(comparahend: dec64, comparator: dec64) returns comparison: dec64
 
 ; Compare two dec64 numbers. If the first is less than the second, return true,
@@ -1390,8 +1577,9 @@ dec64_is_less: function_with_two_parameters
     jmp     return_false            ; nan is not less than nan
     pad
 
-less_slow:
+block   less_slow
 
+    count   stats_less_slow
  ; The exponents are not the same.
 
     cmp     r1_b, 128               ; is the first argument nan?
@@ -1427,7 +1615,7 @@ less_slow:
     jmp     return_false
     pad
 
-less_second:
+block   less_second
 
     neg     r8
     cmp     r8, r2                  ; compare the exponent difference to 18
@@ -1440,21 +1628,22 @@ less_second:
     jmp     return_false
     pad
 
-less_overflow_first:
+block   less_overflow_first
 
     test    r2, r2
     jns     return_false
     jmp     return_true
     pad
 
-less_overflow_second:
+block   less_overflow_second
 
     test    r2, r2
     jns     return_true
     jmp     return_false
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_integer: function_with_one_parameter
+public_block dec64_is_integer
+    function_with_one_parameter
 ;(number: dec64) returns comparison: dec64
 
 ; If the number contains a non-zero fractional part or if it is nan, return
@@ -1481,7 +1670,8 @@ dec64_is_integer: function_with_one_parameter
     jmp     return_false
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_nan: function_with_one_parameter
+public_block dec64_is_nan
+    function_with_one_parameter
 ;(number: dec64) returns comparison: dec64
 
     cmp     r1_b, 128               ; is r1 nan?
@@ -1489,7 +1679,8 @@ dec64_is_nan: function_with_one_parameter
     jmp     return_false
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_zero: function_with_one_parameter
+public_block dec64_is_zero
+    function_with_one_parameter
 ;(number: dec64) returns comparison: dec64
 
     cmp     r1_b, 128               ; is r1 nan?
@@ -1501,7 +1692,8 @@ dec64_is_zero: function_with_one_parameter
     jmp     return_false
     pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
-dec64_is_false: function_with_one_parameter
+public_block dec64_is_false
+    function_with_one_parameter
 ;(boolean: dec64) returns notation: dec64
 
 ; If the argument is false, the result is true.
@@ -1511,15 +1703,52 @@ dec64_is_false: function_with_one_parameter
     cmp     r1, r0
     je      return_true
 
-return_false:
+block   return_false
 
     mov     r0, false
     ret
 
-return_true:
+block   return_true
 
     mov     r0, true
     ret
 
+    pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+public_block dec64_stats
+    function_with_one_parameter
+;(path: int64) returns count: int64
+
+; Return the number of times that a slow path has been entered since the
+; counts were last reset. The counts are only kept if STATS is 1. Otherwise,
+; and for a path that does not exist, the result is 0.
+
+    xor     r0, r0                  ; r0 is zero
+    cmp     r1, stats_nr_paths      ; is the path in range (unsigned)?
+    jae     return                  ; if not, return zero
+    lea     r8, stats               ; r8 is the address of the counts
+    mov     r0, [r8][r1*8]          ; r0 is the count
+    ret
+
+    pad; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+public_block dec64_stats_reset
+;() returns nothing
+
+; Set all of the slow path counts to zero.
+
+    lea     r8, stats               ; r8 is the address of the counts
+    mov     r9, stats_nr_paths      ; r9 is the number of counts
+    xor     r0, r0                  ; r0 is zero
+
+block   stats_reset_loop
+
+    sub     r9, 1                   ; r9 is the index of the next count
+    mov     [r8][r9*8], r0          ; clear the count (mov keeps the flags)
+    jnz     stats_reset_loop        ; until the first count is cleared
+    ret
+
+    block_end
+
 dec64_code ends
     end
@@ -18,6 +18,27 @@ No warranty.
 #define DEC64_TRUE          (0x0000000000000380LL)
 #define DEC64_FALSE         (0x0000000000000280LL)
 
+/*
+    The slow paths in dec64.asm that are counted when it is assembled with
+    STATS set to 1. Pass one of these to dec64_stats. Each count is the number
+    of entries into the path, except for DEC64_STATS_PACK_LARGE, which loops
+    back through pack and so counts each division of a coefficient by ten.
+    dec64.s and dec64.v.s only have stubs of dec64_stats and dec64_stats_reset,
+    so their counts are always 0.
+*/
+
+#define DEC64_STATS_ADD_OVERFLOW        0
+#define DEC64_STATS_ADD_SLOW            1
+#define DEC64_STATS_ADD_SLOWER          2
+#define DEC64_STATS_PACK_LARGE          3
+#define DEC64_STATS_PACK_INCREASE       4
+#define DEC64_STATS_DIVIDE_PRESCALE     5
+#define DEC64_STATS_NORMAL_DIVIDE       6
+#define DEC64_STATS_INTEGER_DIVIDE_SLOW 7
+#define DEC64_STATS_MODULO_SLOW         8
+#define DEC64_STATS_LESS_SLOW           9
+#define DEC64_STATS_NR_PATHS            10
+
 typedef long long int64;
 typedef unsigned long long uint64;
 typedef int64 dec64;
@@ -48,3 +69,6 @@ extern dec64 dec64_normal(dec64 number)                     /* normalization */;
 extern dec64 dec64_round(dec64 number, dec64 place)         /*  quantization */;
 extern dec64 dec64_signum(dec64 number)                     /*     signature */;
 extern dec64 dec64_subtract(dec64 minuend, dec64 subtrahend)/*    difference */;
+
+extern int64 dec64_stats(int64 path)                        /*         count */;
+extern void dec64_stats_reset()                             /*       nothing */;
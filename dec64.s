@@ -149,6 +149,11 @@
     global dec64_subtract [func];(minuend: dec64, subtrahend: dec64)
 ;   returns difference: dec64
 
+    global dec64_stats [func];(path: int64)
+;   returns count: int64
+
+    global dec64_stats_reset [func];()
+
 
 ; All of the public functions in this file accept up to two arguments,
 ; which are passed in registers (x0, x1), returning a result in x0.
@@ -380,7 +385,7 @@ round_normal
 
 dec64_dec;(number: dec64) returns difference: dec64
 
-    mov     x2, 256
+    mov     x1, 256
     b       dec64_subtract
 
 ; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
@@ -388,7 +393,7 @@ dec64_dec;(number: dec64) returns difference: dec64
 
 dec64_inc;(number: dec64) returns sum: dec64
 
-    mov     x2, 256
+    mov     x1, 256
     b       dec64_add
 
 ; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
@@ -1257,4 +1262,20 @@ return_true
     mov     x0, 0x380               ; x0 is true
     ret
 
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+dec64_stats;(path: int64) returns count: int64
+
+; This port does not count slow path entries yet, so every count is 0.
+; See the STATS flag in dec64.asm.
+
+    mov     x0, 0
+    ret
+
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+dec64_stats_reset;() returns nothing
+
+    ret
+
     end
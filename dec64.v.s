@@ -33,7 +33,9 @@
 ;
 ;   dec64_abs(nan)
 ;   dec64_ceiling(nan)
+;   dec64_dec(nan)
 ;   dec64_floor(nan)
+;   dec64_inc(nan)
 ;   dec64_neg(nan)
 ;   dec64_normal(nan)
 ;   dec64_signum(nan)
@@ -87,6 +89,9 @@
     global dec64_coefficient [func];(number: dec64)
 ;   returns coefficient: int64
 
+    global dec64_dec [func];(number: dec64)
+;   returns difference: dec64
+
     global dec64_divide [func];(dividend: dec64, divisor: dec64)
 ;   returns quotient: dec64
 
@@ -96,6 +101,9 @@
     global dec64_floor [func];(number: dec64)
 ;   returns integer: dec64
 
+    global dec64_inc [func];(number: dec64)
+;   returns sum: dec64
+
     global dec64_integer_divide [func];(dividend: dec64, divisor: dec64)
 ;   returns quotient: dec64
 
@@ -141,6 +149,11 @@
     global dec64_subtract [func];(minuend: dec64, subtrahend: dec64)
 ;   returns difference: dec64
 
+    global dec64_stats [func];(path: int64)
+;   returns count: int64
+
+    global dec64_stats_reset [func];()
+
 
 ; All of the public functions in this file accept up to two arguments,
 ; which are passed in registers (x10, x11), returning a result in x10.
@@ -394,6 +407,20 @@ round_normal
 
 ; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
 
+dec64_dec;(number: dec64) returns difference: dec64
+
+    mov     x1, 256
+    b       dec64_subtract
+
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+dec64_inc;(number: dec64) returns sum: dec64
+
+    mov     x1, 256
+    b       dec64_add
+
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
 dec64_add;(augend: dec64, addend: dec64) returns sum: dec64
 
 ; Add two dec64 numbers together.
@@ -1265,4 +1292,20 @@ return_true
     add     x0, x0, 0x380           ; x0 is true
     ret
 
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+dec64_stats;(path: int64) returns count: int64
+
+; This port does not count slow path entries yet, so every count is 0.
+; See the STATS flag in dec64.asm.
+
+    mov     x0, 0
+    ret
+
+; -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- -- --
+
+dec64_stats_reset;() returns nothing
+
+    ret
+
     end
@@ -0,0 +1,537 @@
+/* dec64_bench.c
+
+This is a benchmark of dec64.obj. It measures each of the operators in dec64.h
+with operands of several classes, because the operators take different paths
+depending on their operands:
+
+    integer     the operand has an exponent of 0
+    fraction    the operand has a negative exponent
+    same        the operands have the same exponent
+    differ      the operands have different exponents
+    overflow    the coefficient does not fit and must be scaled, as in
+                add_overflow and pack_large
+    scale       the exponents are so far apart that one operand must be
+                scaled, as in add_slower
+    nan         an operand is nan
+    zero        an operand is zero
+    two         the divisor is 2 and the coefficient is odd (divide_two)
+    two_even    the divisor is 2 and the coefficient is even (divide_half)
+
+Each case is measured for latency, where each call must wait for the result of
+the previous call, and for throughput, where the calls are independent. Each
+measurement is the median of several runs, with the median absolute deviation
+of the runs as a measure of their noise. The results are written as comma
+separated values, one line per case, so that they can be kept and compared:
+
+    operator,class,latency_ns,throughput_ns,latency_cycles,throughput_cycles,
+        latency_mad_ns,throughput_mad_ns
+
+Cycles are read from the time stamp counter on x64, and are 0 elsewhere. The
+number of calls in a run can be given as the first argument.
+
+The output can be kept as a baseline, and later runs compared against it:
+
+    dec64_bench > dec64_bench.csv
+    dec64_bench compare dec64_bench.csv [percent] [nr_calls]
+
+A case regresses if its median is slower than the baseline by more than the
+percent (5 by default), and also by more than three times the sum of the two
+deviations, so that noise alone is not reported. Each measurement is written
+with a verdict of faster, same, slower, regressed, or new:
+
+    operator,class,measure,baseline_ns,current_ns,change_percent,verdict
+
+The exit status is 1 if anything regressed. A baseline is only meaningful on
+the machine that made it, with the same dec64.obj build settings. Alignment
+choices like those made by pad in dec64.asm can regress silently, so record a
+baseline before changing them.
+
+dec64_bench.sh records and compares baselines kept in the repository, one per
+machine, in baseline/dec64_bench_<machine>.csv:
+
+    dec64_bench.sh record
+    dec64_bench.sh compare
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dec64.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define CYCLES() ((double)__rdtsc())
+#else
+#define CYCLES() 0.0
+#endif
+
+#define NR_CALLS 1000000
+#define NR_CASES 128
+#define NR_RUNS 9
+#define THRESHOLD 5.0
+
+typedef dec64 (*unary)(dec64);
+typedef dec64 (*binary)(dec64, dec64);
+
+struct bench_case {
+    char* name;
+    char* class_name;
+    unary unary_function;
+    binary binary_function;
+    dec64 first;
+    dec64 second;
+};
+
+struct result {
+    double latency_ns;
+    double throughput_ns;
+    double latency_cycles;
+    double throughput_cycles;
+    double latency_mad_ns;
+    double throughput_mad_ns;
+};
+
+static struct bench_case cases[NR_CASES];
+static int nr_cases;
+
+/*
+    The mask is always 0, but the compiler cannot know that, so mixing a result
+    into the next operand with it makes the calls wait for each other without
+    changing the operands.
+*/
+
+static volatile int64 mask = 0;
+static volatile dec64 sink;
+
+/* constants */
+
+static dec64 cent;
+static dec64 maxint;
+static dec64 nan;
+static dec64 negative_maxint;
+static dec64 one;
+static dec64 price;
+static dec64 quantity;
+static dec64 rate;
+static dec64 small;
+static dec64 two;
+static dec64 zero;
+
+static void define_constants() {
+    cent = dec64_new(1, -2);
+    maxint = dec64_new(36028797018963967, 0);
+    nan = DEC64_NULL;
+    negative_maxint = dec64_new(-36028797018963968, 0);
+    one = DEC64_ONE;
+    price = dec64_new(12345, -2);
+    quantity = dec64_new(678, -2);
+    rate = dec64_new(678, -5);
+    small = dec64_new(3, -40);
+    two = dec64_new(2, 0);
+    zero = DEC64_ZERO;
+}
+
+static void add_unary(char* name, char* class_name, unary function, dec64 first) {
+    cases[nr_cases].name = name;
+    cases[nr_cases].class_name = class_name;
+    cases[nr_cases].unary_function = function;
+    cases[nr_cases].binary_function = NULL;
+    cases[nr_cases].first = first;
+    cases[nr_cases].second = zero;
+    nr_cases += 1;
+}
+
+static void add_binary(
+    char* name,
+    char* class_name,
+    binary function,
+    dec64 first,
+    dec64 second
+) {
+    cases[nr_cases].name = name;
+    cases[nr_cases].class_name = class_name;
+    cases[nr_cases].unary_function = NULL;
+    cases[nr_cases].binary_function = function;
+    cases[nr_cases].first = first;
+    cases[nr_cases].second = second;
+    nr_cases += 1;
+}
+
+static void add_unary_classes(char* name, unary function) {
+    add_unary(name, "integer", function, dec64_new(12345, 0));
+    add_unary(name, "fraction", function, price);
+    add_unary(name, "nan", function, nan);
+    add_unary(name, "zero", function, zero);
+}
+
+static void add_binary_classes(char* name, binary function) {
+    add_binary(name, "same", function, price, quantity);
+    add_binary(name, "differ", function, price, rate);
+    add_binary(name, "nan", function, nan, price);
+    add_binary(name, "zero", function, zero, price);
+}
+
+static void define_cases() {
+    nr_cases = 0;
+    add_unary_classes("abs", dec64_abs);
+    add_unary("abs", "overflow", dec64_abs, negative_maxint);
+    add_binary_classes("add", dec64_add);
+    add_binary("add", "overflow", dec64_add, maxint, maxint);
+    add_binary("add", "scale", dec64_add, maxint, small);
+    add_unary_classes("ceiling", dec64_ceiling);
+    add_unary_classes("coefficient", dec64_coefficient);
+    add_unary_classes("dec", dec64_dec);
+    add_unary("dec", "overflow", dec64_dec, negative_maxint);
+    add_binary_classes("divide", dec64_divide);
+    add_binary("divide", "overflow", dec64_divide, one, maxint);
+    add_binary("divide", "two", dec64_divide, price, two);
+    add_binary("divide", "two_even", dec64_divide, dec64_new(12344, -2), two);
+    add_unary_classes("exponent", dec64_exponent);
+    add_unary_classes("floor", dec64_floor);
+    add_unary_classes("inc", dec64_inc);
+    add_unary("inc", "overflow", dec64_inc, maxint);
+    add_binary_classes("integer_divide", dec64_integer_divide);
+    add_binary_classes("is_equal", dec64_is_equal);
+    add_unary_classes("is_false", dec64_is_false);
+    add_unary_classes("is_integer", dec64_is_integer);
+    add_binary_classes("is_less", dec64_is_less);
+    add_unary_classes("is_nan", dec64_is_nan);
+    add_unary_classes("is_zero", dec64_is_zero);
+    add_binary_classes("modulo", dec64_modulo);
+    add_binary_classes("multiply", dec64_multiply);
+    add_binary("multiply", "overflow", dec64_multiply, maxint, maxint);
+    add_unary_classes("neg", dec64_neg);
+    add_unary("neg", "overflow", dec64_neg, negative_maxint);
+    add_binary("new", "same", dec64_new, 12345, -2);
+    add_binary("new", "overflow", dec64_new, 1234567890123456789LL, 0);
+    add_binary("new", "zero", dec64_new, 0, 5);
+    add_unary_classes("normal", dec64_normal);
+    add_unary("normal", "overflow", dec64_normal, dec64_new(1, 20));
+    add_binary("round", "same", dec64_round, price, dec64_new(-2, 0));
+    add_binary("round", "differ", dec64_round, price, dec64_new(1, 0));
+    add_binary("round", "nan", dec64_round, nan, cent);
+    add_binary("round", "zero", dec64_round, zero, cent);
+    add_unary_classes("signum", dec64_signum);
+    add_binary_classes("subtract", dec64_subtract);
+    add_binary("subtract", "overflow", dec64_subtract, maxint, negative_maxint);
+    add_binary("subtract", "scale", dec64_subtract, maxint, small);
+}
+
+static double now() {
+/*
+    The time in nanoseconds.
+*/
+    struct timespec time;
+
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+static void run(
+    struct bench_case* c,
+    int latency,
+    int64 nr_calls,
+    double* ns,
+    double* cycles
+) {
+/*
+    Time one run of the case, and deliver the cost of a single call.
+*/
+    int64 at;
+    double cycles_start;
+    dec64 first = c->first;
+    int64 hidden = mask;
+    dec64 result = 0;
+    dec64 second = c->second;
+    double start;
+
+    start = now();
+    cycles_start = CYCLES();
+    if (c->unary_function != NULL) {
+        unary function = c->unary_function;
+        if (latency) {
+            for (at = 0; at < nr_calls; at += 1) {
+                result = function(first ^ (result & hidden));
+            }
+        } else {
+            for (at = 0; at < nr_calls; at += 1) {
+                result ^= function(first);
+            }
+        }
+    } else {
+        binary function = c->binary_function;
+        if (latency) {
+            for (at = 0; at < nr_calls; at += 1) {
+                result = function(first ^ (result & hidden), second);
+            }
+        } else {
+            for (at = 0; at < nr_calls; at += 1) {
+                result ^= function(first, second);
+            }
+        }
+    }
+    *cycles = (CYCLES() - cycles_start) / (double)nr_calls;
+    *ns = (now() - start) / (double)nr_calls;
+    sink = result;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+static void measure(
+    struct bench_case* c,
+    int latency,
+    int64 nr_calls,
+    double* ns,
+    double* cycles,
+    double* mad
+) {
+/*
+    Take the median of the runs, and the median of the absolute deviations of
+    the runs from that median.
+*/
+    double ns_runs[NR_RUNS];
+    double cycles_runs[NR_RUNS];
+    int run_nr;
+
+    for (run_nr = 0; run_nr < NR_RUNS; run_nr += 1) {
+        run(c, latency, nr_calls, &ns_runs[run_nr], &cycles_runs[run_nr]);
+    }
+    qsort(ns_runs, NR_RUNS, sizeof(double), compare_doubles);
+    qsort(cycles_runs, NR_RUNS, sizeof(double), compare_doubles);
+    *ns = ns_runs[NR_RUNS / 2];
+    *cycles = cycles_runs[NR_RUNS / 2];
+    for (run_nr = 0; run_nr < NR_RUNS; run_nr += 1) {
+        ns_runs[run_nr] = (
+            ns_runs[run_nr] > *ns
+            ? ns_runs[run_nr] - *ns
+            : *ns - ns_runs[run_nr]
+        );
+    }
+    qsort(ns_runs, NR_RUNS, sizeof(double), compare_doubles);
+    *mad = ns_runs[NR_RUNS / 2];
+}
+
+static void measure_case(
+    struct bench_case* c,
+    int64 nr_calls,
+    struct result* result
+) {
+    measure(
+        c,
+        1,
+        nr_calls,
+        &result->latency_ns,
+        &result->latency_cycles,
+        &result->latency_mad_ns
+    );
+    measure(
+        c,
+        0,
+        nr_calls,
+        &result->throughput_ns,
+        &result->throughput_cycles,
+        &result->throughput_mad_ns
+    );
+}
+
+static int64 calls_argument(char* argument) {
+    int64 nr_calls = atoll(argument);
+    return nr_calls > 0 ? nr_calls : NR_CALLS;
+}
+
+static void write_results(int64 nr_calls) {
+    int case_nr;
+    struct result result;
+
+    printf(
+        "operator,class,latency_ns,throughput_ns,latency_cycles,"
+        "throughput_cycles,latency_mad_ns,throughput_mad_ns\n"
+    );
+    for (case_nr = 0; case_nr < nr_cases; case_nr += 1) {
+        measure_case(&cases[case_nr], nr_calls, &result);
+        printf(
+            "%s,%s,%.3f,%.3f,%.1f,%.1f,%.3f,%.3f\n",
+            cases[case_nr].name,
+            cases[case_nr].class_name,
+            result.latency_ns,
+            result.throughput_ns,
+            result.latency_cycles,
+            result.throughput_cycles,
+            result.latency_mad_ns,
+            result.throughput_mad_ns
+        );
+    }
+}
+
+static int find_baseline(
+    FILE* file,
+    struct bench_case* c,
+    struct result* baseline
+) {
+/*
+    Find the line for the case in the baseline file. A baseline written before
+    the deviations were added is accepted, with deviations of 0.
+*/
+    char class_name[64];
+    char line[256];
+    char name[64];
+    int nr_fields;
+
+    rewind(file);
+    while (fgets(line, sizeof line, file) != NULL) {
+        baseline->latency_mad_ns = 0;
+        baseline->throughput_mad_ns = 0;
+        nr_fields = sscanf(
+            line,
+            "%63[^,],%63[^,],%lf,%lf,%lf,%lf,%lf,%lf",
+            name,
+            class_name,
+            &baseline->latency_ns,
+            &baseline->throughput_ns,
+            &baseline->latency_cycles,
+            &baseline->throughput_cycles,
+            &baseline->latency_mad_ns,
+            &baseline->throughput_mad_ns
+        );
+        if (
+            nr_fields >= 6
+            && strcmp(name, c->name) == 0
+            && strcmp(class_name, c->class_name) == 0
+        ) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int judge(
+    struct bench_case* c,
+    char* measure_name,
+    int found,
+    double baseline_ns,
+    double baseline_mad,
+    double ns,
+    double mad,
+    double threshold
+) {
+/*
+    Write a line comparing a measurement with its baseline. Return 1 if it
+    regressed.
+*/
+    double change = 0;
+    double difference = ns - baseline_ns;
+    double noise = 3 * (baseline_mad + mad);
+    char* verdict = "new";
+
+    if (found) {
+        if (baseline_ns > 0) {
+            change = difference * 100 / baseline_ns;
+        }
+        if (change > threshold && difference > noise) {
+            verdict = "regressed";
+        } else if (change > threshold) {
+            verdict = "slower";
+        } else if (change < -threshold && -difference > noise) {
+            verdict = "faster";
+        } else {
+            verdict = "same";
+        }
+    }
+    printf(
+        "%s,%s,%s,%.3f,%.3f,%.1f,%s\n",
+        c->name,
+        c->class_name,
+        measure_name,
+        baseline_ns,
+        ns,
+        change,
+        verdict
+    );
+    return verdict[0] == 'r';
+}
+
+static int compare_results(char* file_name, double threshold, int64 nr_calls) {
+    struct result baseline;
+    int case_nr;
+    FILE* file = fopen(file_name, "r");
+    int found;
+    int nr_regressed = 0;
+    struct result result;
+
+    if (file == NULL) {
+        fprintf(stderr, "Unable to read %s.\n", file_name);
+        return 2;
+    }
+    printf("operator,class,measure,baseline_ns,current_ns,change_percent,verdict\n");
+    for (case_nr = 0; case_nr < nr_cases; case_nr += 1) {
+        found = find_baseline(file, &cases[case_nr], &baseline);
+        if (!found) {
+            memset(&baseline, 0, sizeof baseline);
+        }
+        measure_case(&cases[case_nr], nr_calls, &result);
+        nr_regressed += judge(
+            &cases[case_nr],
+            "latency",
+            found,
+            baseline.latency_ns,
+            baseline.latency_mad_ns,
+            result.latency_ns,
+            result.latency_mad_ns,
+            threshold
+        );
+        nr_regressed += judge(
+            &cases[case_nr],
+            "throughput",
+            found,
+            baseline.throughput_ns,
+            baseline.throughput_mad_ns,
+            result.throughput_ns,
+            result.throughput_mad_ns,
+            threshold
+        );
+    }
+    fclose(file);
+    if (nr_regressed > 0) {
+        fprintf(stderr, "%i measurements regressed.\n", nr_regressed);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    double threshold = THRESHOLD;
+
+    define_constants();
+    define_cases();
+    if (argc > 1 && strcmp(argv[1], "compare") == 0) {
+        if (argc < 3) {
+            fprintf(stderr, "Usage: dec64_bench compare baseline [percent] [nr_calls]\n");
+            return 2;
+        }
+        if (argc > 3 && atof(argv[3]) > 0) {
+            threshold = atof(argv[3]);
+        }
+        return compare_results(
+            argv[2],
+            threshold,
+            argc > 4 ? calls_argument(argv[4]) : NR_CALLS
+        );
+    }
+    write_results(argc > 1 ? calls_argument(argv[1]) : NR_CALLS);
+    return 0;
+}
@@ -0,0 +1,59 @@
+#!/bin/sh
+
+# dec64_bench.sh
+#
+# Record and compare dec64_bench baselines, so that a performance gate can be
+# run like a test:
+#
+#     dec64_bench.sh record [machine]
+#     dec64_bench.sh compare [machine]
+#
+# A baseline is only meaningful on the machine that made it, so each machine
+# has its own file, kept in the repository at
+#
+#     baseline/dec64_bench_<machine>.csv
+#
+# The machine name is the host name unless it is given. record runs the
+# benchmark and writes the baseline. compare runs the benchmark against the
+# baseline and exits with 1 if anything regressed, or 2 if there is no
+# baseline for the machine. Record a new baseline, and commit it, when a change
+# is meant to alter the speed.
+#
+# These variables can be set:
+#
+#     DEC64_BENCH     the benchmark program, ./dec64_bench by default
+#     PERCENT         the regression threshold in percent, 5 by default
+#     NR_CALLS        the number of calls in a run, dec64_bench's default if
+#                     not set
+#
+# dec64.com
+# 2026-10-19
+# Public Domain
+#
+# No warranty.
+
+bench="${DEC64_BENCH:-./dec64_bench}"
+percent="${PERCENT:-5}"
+machine="${2:-$(uname -n)}"
+directory="$(dirname "$0")/baseline"
+baseline="$directory/dec64_bench_$machine.csv"
+
+case "$1" in
+record)
+    mkdir -p "$directory" || exit 2
+    "$bench" $NR_CALLS > "$baseline.new" || exit 2
+    mv "$baseline.new" "$baseline"
+    echo "Recorded $baseline." >&2
+    ;;
+compare)
+    if [ ! -f "$baseline" ]; then
+        echo "There is no baseline $baseline. Run dec64_bench.sh record." >&2
+        exit 2
+    fi
+    "$bench" compare "$baseline" "$percent" $NR_CALLS
+    ;;
+*)
+    echo "Usage: dec64_bench.sh record|compare [machine]" >&2
+    exit 2
+    ;;
+esac
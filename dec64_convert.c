@@ -0,0 +1,809 @@
+/*
+dec64_convert.c
+Conversion between DEC64 and other number types.
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+
+This file contains dec64_from_integers and dec64_to_integers, which convert
+whole arrays at a time between DEC64 and scaled integers, and
+dec64_from_double and dec64_to_double, which convert between DEC64 and IEEE
+754 double precision binary floating point.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "dec64.h"
+#include "dec64_convert.h"
+
+static const int64 power[19] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000
+};
+
+/*
+    The powers of ten that are exactly representable as doubles.
+*/
+
+static const double double_power[23] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+    1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+    1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/* functions in service to dec64_from_integers */
+
+static dec64_convert_flag from_integer_slow(
+    int64 integer,
+    int64 exponent,
+    dec64* number
+) {
+/*
+    The integer does not fit in a coefficient, or the exponent is out of range.
+    Let dec64_new round it, and then determine what was lost.
+*/
+    int64 difference;
+    dec64 result = dec64_new(integer, exponent);
+    *number = result;
+    if (dec64_is_nan(result) == DEC64_TRUE) {
+        return DEC64_OVERFLOW;
+    }
+    if (result == DEC64_ZERO) {
+        return (
+            integer == 0
+            ? 0
+            : DEC64_INEXACT
+        );
+    }
+    difference = dec64_exponent(result) - exponent;
+    if (difference <= 0) {
+        return 0;
+    }
+    if (
+        difference > 18
+        || integer % power[difference] != 0
+        || integer / power[difference] != dec64_coefficient(result)
+    ) {
+        return DEC64_INEXACT;
+    }
+    return 0;
+}
+
+/* functions in service to dec64_to_integers */
+
+static dec64_convert_flag to_integer(
+    dec64 number,
+    int64 exponent,
+    int64* integer
+) {
+    int64 coefficient;
+    int64 difference;
+    int64 quotient;
+    int64 remainder;
+
+    *integer = 0;
+    if (dec64_is_nan(number) == DEC64_TRUE) {
+        return DEC64_OVERFLOW;
+    }
+    coefficient = dec64_coefficient(number);
+    if (coefficient == 0) {
+        return 0;
+    }
+    difference = dec64_exponent(number) - exponent;
+    if (difference == 0) {
+        *integer = coefficient;
+        return 0;
+    }
+/*
+    If the number has a larger exponent, then the coefficient must be scaled
+    up, which can overflow.
+*/
+    if (difference > 0) {
+        if (
+            difference > 18
+            || coefficient > 0x7FFFFFFFFFFFFFFFLL / power[difference]
+            || coefficient < -0x7FFFFFFFFFFFFFFFLL / power[difference]
+        ) {
+            return DEC64_OVERFLOW;
+        }
+        *integer = coefficient * power[difference];
+        return 0;
+    }
+/*
+    If the number has a smaller exponent, then the coefficient must be scaled
+    down, which can lose digits. Round half away from zero, like dec64_round.
+    No coefficient is as large as half of 10**17.
+*/
+    difference = -difference;
+    if (difference > 17) {
+        return DEC64_INEXACT;
+    }
+    quotient = coefficient / power[difference];
+    remainder = coefficient % power[difference];
+    if (remainder == 0) {
+        *integer = quotient;
+        return 0;
+    }
+    if (remainder < 0) {
+        if (-remainder * 2 >= power[difference]) {
+            quotient -= 1;
+        }
+    } else {
+        if (remainder * 2 >= power[difference]) {
+            quotient += 1;
+        }
+    }
+    *integer = quotient;
+    return DEC64_INEXACT;
+}
+
+/* functions in service to dec64_from_double and dec64_to_double */
+
+/*
+    When a fast conversion is not possible, the conversion is done exactly with
+    big unsigned integers that have 32 bits in each limb, least significant
+    first. A limb is kept in a uint64 so that a product fits. 40 limbs is
+    enough for the whole double range.
+*/
+
+#define BIG_LIMBS 40
+
+typedef struct big {
+    int64 length;
+    uint64 limb[BIG_LIMBS];
+} big;
+
+static void big_set(big* a, uint64 value) {
+    a->length = 0;
+    while (value != 0) {
+        a->limb[a->length] = value & 0xFFFFFFFF;
+        a->length += 1;
+        value >>= 32;
+    }
+}
+
+static int64 big_bits(big* a) {
+    int64 bits;
+    uint64 top;
+
+    if (a->length == 0) {
+        return 0;
+    }
+    bits = (a->length - 1) * 32;
+    top = a->limb[a->length - 1];
+    while (top != 0) {
+        bits += 1;
+        top >>= 1;
+    }
+    return bits;
+}
+
+static int big_compare(big* a, big* b) {
+    int64 at;
+
+    if (a->length != b->length) {
+        return (
+            a->length < b->length
+            ? -1
+            : 1
+        );
+    }
+    for (at = a->length - 1; at >= 0; at -= 1) {
+        if (a->limb[at] != b->limb[at]) {
+            return (
+                a->limb[at] < b->limb[at]
+                ? -1
+                : 1
+            );
+        }
+    }
+    return 0;
+}
+
+static void big_multiply(big* a, uint64 multiplier) {
+/*
+    Multiply by a number less than 2**32.
+*/
+    int64 at;
+    uint64 carry = 0;
+
+    for (at = 0; at < a->length; at += 1) {
+        uint64 product = a->limb[at] * multiplier + carry;
+        a->limb[at] = product & 0xFFFFFFFF;
+        carry = product >> 32;
+    }
+    if (carry != 0) {
+        a->limb[a->length] = carry;
+        a->length += 1;
+    }
+}
+
+static void big_multiply_power(big* a, int64 exponent) {
+/*
+    Multiply by 10**exponent, 9 digits at a time.
+*/
+    while (exponent >= 9) {
+        big_multiply(a, 1000000000);
+        exponent -= 9;
+    }
+    if (exponent > 0) {
+        big_multiply(a, (uint64)power[exponent]);
+    }
+}
+
+static void big_shift(big* a, int64 bits) {
+/*
+    Shift left.
+*/
+    int64 at;
+    int64 limbs = bits >> 5;
+
+    bits &= 31;
+    if (a->length == 0) {
+        return;
+    }
+    if (bits != 0) {
+        a->limb[a->length] = 0;
+        for (at = a->length; at > 0; at -= 1) {
+            a->limb[at] = (
+                (a->limb[at] << bits) | (a->limb[at - 1] >> (32 - bits))
+            ) & 0xFFFFFFFF;
+        }
+        a->limb[0] = (a->limb[0] << bits) & 0xFFFFFFFF;
+        if (a->limb[a->length] != 0) {
+            a->length += 1;
+        }
+    }
+    if (limbs != 0) {
+        for (at = a->length - 1; at >= 0; at -= 1) {
+            a->limb[at + limbs] = a->limb[at];
+        }
+        for (at = 0; at < limbs; at += 1) {
+            a->limb[at] = 0;
+        }
+        a->length += limbs;
+    }
+}
+
+static void big_subtract(big* a, big* b) {
+/*
+    a is not smaller than b.
+*/
+    int64 at;
+    uint64 borrow = 0;
+
+    for (at = 0; at < a->length; at += 1) {
+        uint64 subtrahend = (
+            at < b->length
+            ? b->limb[at]
+            : 0
+        ) + borrow;
+        borrow = a->limb[at] < subtrahend;
+        a->limb[at] = (a->limb[at] - subtrahend) & 0xFFFFFFFF;
+    }
+    while (a->length > 0 && a->limb[a->length - 1] == 0) {
+        a->length -= 1;
+    }
+}
+
+static double make_double(uint64 sign, uint64 significand, int64 exponent) {
+/*
+    Assemble a double from a sign bit, a 53 bit significand, and a binary
+    exponent that is within the normal range.
+*/
+    double result;
+    uint64 bits = (
+        (sign << 63)
+        | ((uint64)(exponent + 1075) << 52)
+        | (significand & 0xFFFFFFFFFFFFFULL)
+    );
+    memcpy(&result, &bits, sizeof(double));
+    return result;
+}
+
+static double to_double_slow(int64 coefficient, int64 exponent) {
+/*
+    Divide coefficient * 10**exponent into a quotient and remainder that are
+    exact, and use them to round to the nearest double, ties to even. Every
+    nonzero dec64 number is well within the range of normal doubles.
+*/
+    big denominator;
+    big numerator;
+    int64 at;
+    int64 binary;
+    uint64 guard;
+    uint64 quotient;
+    uint64 sign = 0;
+
+    if (coefficient < 0) {
+        sign = 1;
+        coefficient = -coefficient;
+    }
+    big_set(&numerator, (uint64)coefficient);
+    big_set(&denominator, 1);
+    if (exponent > 0) {
+        big_multiply_power(&numerator, exponent);
+    } else {
+        big_multiply_power(&denominator, -exponent);
+    }
+
+/*
+    Scale so that 1 <= numerator / denominator < 2. The value is then
+    numerator / denominator * 2**binary.
+*/
+
+    binary = big_bits(&numerator) - big_bits(&denominator);
+    if (binary > 0) {
+        big_shift(&denominator, binary);
+    } else {
+        big_shift(&numerator, -binary);
+    }
+    if (big_compare(&numerator, &denominator) < 0) {
+        big_shift(&numerator, 1);
+        binary -= 1;
+    }
+
+/*
+    Develop 54 bits of quotient, which is the significand and a guard bit.
+*/
+
+    quotient = 0;
+    for (at = 0; at < 54; at += 1) {
+        quotient <<= 1;
+        if (big_compare(&numerator, &denominator) >= 0) {
+            big_subtract(&numerator, &denominator);
+            quotient += 1;
+        }
+        big_shift(&numerator, 1);
+    }
+    guard = quotient & 1;
+    quotient >>= 1;
+    if (guard != 0 && (numerator.length != 0 || (quotient & 1) != 0)) {
+        quotient += 1;
+        if (quotient == 0x20000000000000ULL) {
+            quotient >>= 1;
+            binary += 1;
+        }
+    }
+    return make_double(sign, quotient, binary - 52);
+}
+
+static double to_double(dec64 number) {
+    int64 coefficient = number >> 8;
+    int64 exponent = (signed char)(number & 0xFF);
+    uint64 nan_bits = 0x7FF8000000000000ULL;
+    double result;
+
+    if (exponent == -128) {
+        memcpy(&result, &nan_bits, sizeof(double));
+        return result;
+    }
+    if (coefficient == 0) {
+        return 0.0;
+    }
+
+/*
+    If the coefficient and the power of ten are both exactly representable,
+    then a single multiply or divide delivers the correctly rounded result.
+    This assumes that doubles are evaluated in double precision.
+*/
+
+    if (coefficient <= 0x20000000000000LL && coefficient >= -0x20000000000000LL) {
+        if (exponent >= 0 && exponent <= 22) {
+            return (double)coefficient * double_power[exponent];
+        }
+        if (exponent < 0 && exponent >= -22) {
+            return (double)coefficient / double_power[-exponent];
+        }
+        if (
+            exponent > 22
+            && exponent <= 22 + 15
+            && (
+                coefficient < 0
+                ? -coefficient
+                : coefficient
+            ) <= 0x20000000000000LL / power[exponent - 22]
+        ) {
+            return (
+                (double)(coefficient * power[exponent - 22])
+                * double_power[22]
+            );
+        }
+    }
+    return to_double_slow(coefficient, exponent);
+}
+
+static dec64 from_double_candidate(
+    int64 sign,
+    char digits[],
+    int64 nr_digits,
+    int64 exponent
+) {
+/*
+    Round the digits to nr_digits, half away from zero, dropping trailing
+    zeros.
+*/
+    int64 at;
+    int64 coefficient = 0;
+
+    for (at = 0; at < nr_digits; at += 1) {
+        coefficient = coefficient * 10 + digits[at];
+    }
+    if (digits[nr_digits] >= 5) {
+        coefficient += 1;
+    }
+    exponent -= nr_digits - 1;
+    while (coefficient != 0 && coefficient % 10 == 0) {
+        coefficient /= 10;
+        exponent += 1;
+    }
+    return dec64_new(sign * coefficient, exponent);
+}
+
+static dec64_convert_flag from_double_slow(
+    double number,
+    uint64 bits,
+    dec64* result
+) {
+/*
+    Produce the first 18 significant digits exactly, and then find the
+    fewest of them, 15, 16, or 17, that converts back to the same double.
+    If the nearest double of fewer than 15 digits converts back, then rounding
+    to 15 digits finds it padded with zeros, which are then dropped.
+*/
+    big denominator;
+    char digits[18];
+    int64 at;
+    int64 binary = (int64)((bits >> 52) & 0x7FF);
+    int64 decimal;
+    big numerator;
+    int64 sign = (
+        (bits >> 63) != 0
+        ? -1
+        : 1
+    );
+    uint64 significand = bits & 0xFFFFFFFFFFFFFULL;
+    big ten_denominator;
+
+    if (binary == 0) {
+        binary = 1;
+    } else {
+        significand |= 0x10000000000000ULL;
+    }
+    binary -= 1075;
+    big_set(&numerator, significand);
+    big_set(&denominator, 1);
+    if (binary > 0) {
+        big_shift(&numerator, binary);
+    } else {
+        big_shift(&denominator, -binary);
+    }
+
+/*
+    Estimate the decimal exponent from the binary exponent, and then correct
+    it so that 1 <= numerator / denominator < 10. The value is then
+    numerator / denominator * 10**decimal.
+*/
+
+    decimal = (big_bits(&numerator) - big_bits(&denominator)) * 30103 / 100000;
+    if (decimal > 0) {
+        big_multiply_power(&denominator, decimal);
+    } else {
+        big_multiply_power(&numerator, -decimal);
+    }
+    while (big_compare(&numerator, &denominator) < 0) {
+        big_multiply(&numerator, 10);
+        decimal -= 1;
+    }
+    ten_denominator = denominator;
+    big_multiply(&ten_denominator, 10);
+    while (big_compare(&numerator, &ten_denominator) >= 0) {
+        denominator = ten_denominator;
+        big_multiply(&ten_denominator, 10);
+        decimal += 1;
+    }
+    for (at = 0; at < 18; at += 1) {
+        digits[at] = 0;
+        while (big_compare(&numerator, &denominator) >= 0) {
+            big_subtract(&numerator, &denominator);
+            digits[at] += 1;
+        }
+        big_multiply(&numerator, 10);
+    }
+    for (at = 15; at < 17; at += 1) {
+        *result = from_double_candidate(sign, digits, at, decimal);
+        if (to_double(*result) == number) {
+            return 0;
+        }
+    }
+    *result = from_double_candidate(sign, digits, 17, decimal);
+    if (dec64_is_nan(*result) == DEC64_TRUE) {
+        return DEC64_OVERFLOW;
+    }
+    return (
+        to_double(*result) == number
+        ? 0
+        : DEC64_INEXACT
+    );
+}
+
+static dec64_convert_flag from_double(double number, dec64* result) {
+    uint64 bits;
+    int64 coefficient;
+    double magnitude;
+    int64 places;
+    double remainder;
+    double scaled;
+
+    *result = DEC64_NULL;
+    memcpy(&bits, &number, sizeof(double));
+    if (((bits >> 52) & 0x7FF) == 0x7FF) {
+        return DEC64_OVERFLOW;
+    }
+    magnitude = (
+        number < 0
+        ? -number
+        : number
+    );
+    if (magnitude > 1e145) {
+        return DEC64_OVERFLOW;
+    }
+    if (magnitude < 1e-130) {
+        *result = DEC64_ZERO;
+        return (
+            number == 0
+            ? 0
+            : DEC64_INEXACT
+        );
+    }
+
+/*
+    Most doubles came from short decimal numbers. Try scaling by each exact
+    power of ten, looking for an integer that converts back to the same
+    double with a single correctly rounded division. Decimals of 15 digits are
+    too far apart for two of them to convert back to the same double, so an
+    integer under 10**15 that does is the shortest and the nearest.
+*/
+
+    for (places = 0; places <= 22; places += 1) {
+        scaled = number * double_power[places];
+        if (scaled >= 1e15 || scaled <= -1e15) {
+            break;
+        }
+        coefficient = (int64)scaled;
+        remainder = scaled - (double)coefficient;
+        if (remainder >= 0.5) {
+            coefficient += 1;
+        } else if (remainder <= -0.5) {
+            coefficient -= 1;
+        }
+        if ((double)coefficient / double_power[places] == number) {
+            *result = dec64_new(coefficient, -places);
+            return 0;
+        }
+    }
+    return from_double_slow(number, bits, result);
+}
+
+/* Action. */
+
+int64 dec64_from_integers(
+    int64 integers[],
+    int64 exponent,
+    dec64 numbers[],
+    dec64_convert_flag flags[],
+    int64 length
+) {
+/*
+    Convert length integers to dec64 numbers, each being integer * 10**exponent.
+    This is like calling dec64_new(integers[i], exponent) on each element. For
+    example, prices given in units of 1e-8 can be converted with an exponent of
+    -8.
+
+    If flags is not NULL, then each element of flags is set to 0 if the
+    conversion was exact, DEC64_INEXACT if it was rounded, or DEC64_OVERFLOW if
+    it produced nan. It returns the number of elements that were not exact.
+
+    The usual case, where every integer fits in a coefficient, is done in a
+    single pass without calls or branches, which compilers can vectorize.
+*/
+    int64 at;
+    int64 excess;
+    dec64_convert_flag flag;
+    int64 nr_inexact;
+    uint64 tail;
+
+    if (integers == NULL || numbers == NULL || length <= 0) {
+        return 0;
+    }
+    if (flags != NULL) {
+        memset(flags, 0, (size_t)length);
+    }
+    nr_inexact = 0;
+    if (exponent >= -127 && exponent <= 127) {
+        tail = (uint64)exponent & 0xFF;
+        excess = 0;
+        for (at = 0; at < length; at += 1) {
+            int64 integer = integers[at];
+            numbers[at] = (dec64)(
+                ((uint64)integer << 8)
+                | (tail & (0 - (uint64)(integer != 0)))
+            );
+            excess |= (int64)(((uint64)integer + 0x80000000000000ULL) >> 56);
+        }
+        if (excess == 0) {
+            return 0;
+        }
+    }
+/*
+    Some of the integers are too big, or the exponent is out of range. Redo the
+    elements that need it.
+*/
+    for (at = 0; at < length; at += 1) {
+        int64 integer = integers[at];
+        if (
+            exponent < -127
+            || exponent > 127
+            || ((uint64)integer + 0x80000000000000ULL) >> 56 != 0
+        ) {
+            flag = from_integer_slow(integer, exponent, &numbers[at]);
+            if (flag != 0) {
+                nr_inexact += 1;
+                if (flags != NULL) {
+                    flags[at] = flag;
+                }
+            }
+        }
+    }
+    return nr_inexact;
+}
+
+int64 dec64_to_integers(
+    dec64 numbers[],
+    int64 exponent,
+    int64 integers[],
+    dec64_convert_flag flags[],
+    int64 length
+) {
+/*
+    Convert length dec64 numbers to integers scaled by 10**-exponent, so that
+    each number is approximately integers[i] * 10**exponent. Numbers with more
+    digits are rounded like dec64_round.
+
+    If flags is not NULL, then each element of flags is set to 0 if the
+    conversion was exact, DEC64_INEXACT if it was rounded, or DEC64_OVERFLOW if
+    the number is nan or too large for an int64, in which case the integer is
+    0. It returns the number of elements that were not exact.
+*/
+    int64 at;
+    dec64_convert_flag flag;
+    uint64 mismatch;
+    int64 nr_inexact;
+    uint64 tail;
+
+    if (numbers == NULL || integers == NULL || length <= 0) {
+        return 0;
+    }
+    if (flags != NULL) {
+        memset(flags, 0, (size_t)length);
+    }
+/*
+    The usual case is that every number already has the target exponent, so
+    the coefficients can be taken in a single pass without calls or branches.
+*/
+    tail = (uint64)exponent & 0xFF;
+    if (exponent >= -127 && exponent <= 127) {
+        mismatch = 0;
+        for (at = 0; at < length; at += 1) {
+            dec64 number = numbers[at];
+            integers[at] = number >> 8;
+            mismatch |= ((uint64)number ^ tail) & 0xFF;
+        }
+        if (mismatch == 0) {
+            return 0;
+        }
+    }
+    nr_inexact = 0;
+    for (at = 0; at < length; at += 1) {
+        dec64 number = numbers[at];
+        if (
+            exponent < -127
+            || exponent > 127
+            || (((uint64)number ^ tail) & 0xFF) != 0
+        ) {
+            flag = to_integer(number, exponent, &integers[at]);
+            if (flag != 0) {
+                nr_inexact += 1;
+                if (flags != NULL) {
+                    flags[at] = flag;
+                }
+            }
+        }
+    }
+    return nr_inexact;
+}
+
+dec64 dec64_from_double(double number) {
+/*
+    Convert a double to the dec64 with the fewest digits that converts back
+    to the same double. If there is no such dec64 because the double needs all
+    17 digits and the coefficient is too large, or because the double is too
+    small, then the result is the nearest dec64. NaN, the infinities, and
+    doubles that are too large produce nan.
+*/
+    dec64 result;
+    from_double(number, &result);
+    return result;
+}
+
+double dec64_to_double(dec64 number) {
+/*
+    Convert a dec64 to the nearest double, ties to even. nan produces NaN.
+*/
+    return to_double(number);
+}
+
+int64 dec64_from_doubles(
+    double doubles[],
+    dec64 numbers[],
+    dec64_convert_flag flags[],
+    int64 length
+) {
+/*
+    Convert length doubles with dec64_from_double. If flags is not NULL, then
+    each element of flags is set to 0 if the dec64 converts back to the same
+    double, DEC64_INEXACT if it does not, or DEC64_OVERFLOW if it is nan. It
+    returns the number of elements that were not exact.
+*/
+    int64 at;
+    dec64_convert_flag flag;
+    int64 nr_inexact = 0;
+
+    if (doubles == NULL || numbers == NULL || length <= 0) {
+        return 0;
+    }
+    for (at = 0; at < length; at += 1) {
+        flag = from_double(doubles[at], &numbers[at]);
+        if (flag != 0) {
+            nr_inexact += 1;
+        }
+        if (flags != NULL) {
+            flags[at] = flag;
+        }
+    }
+    return nr_inexact;
+}
+
+void dec64_to_doubles(dec64 numbers[], double doubles[], int64 length) {
+/*
+    Convert length dec64 numbers with dec64_to_double.
+*/
+    int64 at;
+
+    if (numbers == NULL || doubles == NULL) {
+        return;
+    }
+    for (at = 0; at < length; at += 1) {
+        doubles[at] = to_double(numbers[at]);
+    }
+}
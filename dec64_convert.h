@@ -0,0 +1,49 @@
+/* dec64_convert.h
+
+The dec64_convert header file. This is the companion to dec64_convert.c.
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+/*
+    Conversion flags. A flags array receives one of these, or 0, for each
+    element that is converted.
+*/
+
+#define DEC64_INEXACT       (1)
+#define DEC64_OVERFLOW      (2)
+
+typedef unsigned char dec64_convert_flag;
+
+extern int64 dec64_from_integers(
+    int64 integers[],
+    int64 exponent,
+    dec64 numbers[],
+    dec64_convert_flag flags[],
+    int64 length
+);
+
+extern int64 dec64_to_integers(
+    dec64 numbers[],
+    int64 exponent,
+    int64 integers[],
+    dec64_convert_flag flags[],
+    int64 length
+);
+
+extern dec64 dec64_from_double(double number);
+
+extern double dec64_to_double(dec64 number);
+
+extern int64 dec64_from_doubles(
+    double doubles[],
+    dec64 numbers[],
+    dec64_convert_flag flags[],
+    int64 length
+);
+
+extern void dec64_to_doubles(dec64 numbers[], double doubles[], int64 length);
@@ -0,0 +1,436 @@
+/* dec64_convert_test.c
+
+This is a test of dec64_convert.c.
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "dec64.h"
+#include "dec64_convert.h"
+
+static int level;
+static int nr_fail;
+static int nr_pass;
+
+static void print_dec64(dec64 number) {
+    int64 exponent = dec64_exponent(number);
+    int64 coefficient = dec64_coefficient(number);
+    printf("%20lli", coefficient);
+    if (exponent == -128) {
+        printf(" nan");
+    } else if (exponent != 0) {
+        printf("e%-+4lli", exponent);
+    }
+}
+
+static void judge(
+    int ok,
+    char * name,
+    int64 at,
+    dec64 number,
+    int64 integer,
+    int flag
+) {
+    if (ok) {
+        nr_pass += 1;
+        if (level >= 3) {
+            printf("\n\npass %s [%lli]", name, at);
+        }
+    } else {
+        nr_fail += 1;
+        if (level >= 1) {
+            printf("\n\nFAIL %s [%lli]", name, at);
+            if (level >= 2) {
+                printf("\n%-4s", "?");
+                print_dec64(number);
+                printf("  %lli  flag %i", integer, flag);
+            }
+        }
+    }
+}
+
+static void test_from_integers(
+    char * name,
+    int64 integers[],
+    int64 exponent,
+    dec64 expected[],
+    dec64_convert_flag expected_flags[],
+    int64 length
+) {
+/*
+    Convert the integers all at once, and then compare each element, and also
+    compare with converting each integer separately.
+*/
+    int64 at;
+    dec64_convert_flag flags[16];
+    int64 nr_expected = 0;
+    int64 nr_inexact;
+    dec64 numbers[16];
+    dec64 single;
+
+    nr_inexact = dec64_from_integers(integers, exponent, numbers, flags, length);
+    for (at = 0; at < length; at += 1) {
+        if (expected_flags[at] != 0) {
+            nr_expected += 1;
+        }
+        dec64_from_integers(&integers[at], exponent, &single, NULL, 1);
+        judge(
+            (
+                numbers[at] == expected[at]
+                || dec64_is_equal(numbers[at], expected[at]) == DEC64_TRUE
+            )
+            && numbers[at] == single
+            && flags[at] == expected_flags[at],
+            name,
+            at,
+            numbers[at],
+            integers[at],
+            flags[at]
+        );
+    }
+    judge(nr_inexact == nr_expected, name, -1, DEC64_NULL, nr_inexact, 0);
+}
+
+static void test_to_integers(
+    char * name,
+    dec64 numbers[],
+    int64 exponent,
+    int64 expected[],
+    dec64_convert_flag expected_flags[],
+    int64 length
+) {
+    int64 at;
+    dec64_convert_flag flags[16];
+    int64 integers[16];
+    int64 nr_expected = 0;
+    int64 nr_inexact;
+    int64 single;
+
+    nr_inexact = dec64_to_integers(numbers, exponent, integers, flags, length);
+    for (at = 0; at < length; at += 1) {
+        if (expected_flags[at] != 0) {
+            nr_expected += 1;
+        }
+        dec64_to_integers(&numbers[at], exponent, &single, NULL, 1);
+        judge(
+            integers[at] == expected[at]
+            && integers[at] == single
+            && flags[at] == expected_flags[at],
+            name,
+            at,
+            numbers[at],
+            integers[at],
+            flags[at]
+        );
+    }
+    judge(nr_inexact == nr_expected, name, -1, DEC64_NULL, nr_inexact, 0);
+}
+
+static void test_from_double(double number, dec64 expected) {
+    dec64 actual = dec64_from_double(number);
+    judge(
+        actual == expected
+        || dec64_is_equal(actual, expected) == DEC64_TRUE,
+        "from double",
+        0,
+        actual,
+        0,
+        0
+    );
+    if (actual != expected && level >= 2) {
+        printf("\n%-4s%.17g\n%-4s", "", number, "=");
+        print_dec64(expected);
+    }
+}
+
+static void test_to_double(dec64 number, double expected) {
+    double actual = dec64_to_double(number);
+    judge(actual == expected, "to double", 0, number, 0, 0);
+    if (actual != expected && level >= 2) {
+        printf("\n%-4s%.17g\n%-4s%.17g", "?", actual, "=", expected);
+    }
+}
+
+static void test_all_from_integers() {
+    int64 prices[6] = {
+        0,
+        1,
+        -1,
+        12345678901,
+        -36028797018963968,
+        36028797018963967
+    };
+    dec64 prices_expected[6];
+    dec64_convert_flag prices_flags[6] = {0, 0, 0, 0, 0, 0};
+
+    int64 large[5] = {
+        36028797018963970,
+        360287970189639700,
+        -360287970189639685,
+        1234567890123456789,
+        5
+    };
+    dec64 large_expected[5];
+    dec64_convert_flag large_flags[5] = {0, 0, DEC64_INEXACT, DEC64_INEXACT, 0};
+
+    int64 high[3] = {0, 1, 100};
+    dec64 high_expected[3];
+    dec64_convert_flag high_flags[3] = {0, DEC64_OVERFLOW, DEC64_OVERFLOW};
+
+    int64 low[3] = {0, 15, 150};
+    dec64 low_expected[3];
+    dec64_convert_flag low_flags[3] = {0, DEC64_INEXACT, 0};
+
+    prices_expected[0] = DEC64_ZERO;
+    prices_expected[1] = dec64_new(1, -8);
+    prices_expected[2] = dec64_new(-1, -8);
+    prices_expected[3] = dec64_new(12345678901, -8);
+    prices_expected[4] = dec64_new(-36028797018963968, -8);
+    prices_expected[5] = dec64_new(36028797018963967, -8);
+    test_from_integers(
+        "from prices",
+        prices,
+        -8,
+        prices_expected,
+        prices_flags,
+        6
+    );
+
+    large_expected[0] = dec64_new(3602879701896397, 1);
+    large_expected[1] = dec64_new(3602879701896397, 2);
+    large_expected[2] = dec64_new(-3602879701896397, 2);
+    large_expected[3] = dec64_new(12345678901234568, 2);
+    large_expected[4] = dec64_new(5, 0);
+    test_from_integers(
+        "from large",
+        large,
+        0,
+        large_expected,
+        large_flags,
+        5
+    );
+
+    high_expected[0] = DEC64_ZERO;
+    high_expected[1] = DEC64_NULL;
+    high_expected[2] = DEC64_NULL;
+    test_from_integers(
+        "from high",
+        high,
+        200,
+        high_expected,
+        high_flags,
+        3
+    );
+
+    low_expected[0] = DEC64_ZERO;
+    low_expected[1] = dec64_new(2, -127);
+    low_expected[2] = dec64_new(15, -127);
+    test_from_integers(
+        "from low",
+        low,
+        -128,
+        low_expected,
+        low_flags,
+        3
+    );
+}
+
+static void test_all_to_integers() {
+    dec64 prices[6];
+    int64 prices_expected[6] = {
+        0,
+        123450000000,
+        -1,
+        100000000,
+        100000000,
+        -36028797018963968
+    };
+    dec64_convert_flag prices_flags[6] = {0, 0, 0, 0, 0, 0};
+
+    dec64 cents[8];
+    int64 cents_expected[8] = {0, 0, 1, -1, 124, -124, 123, 123};
+    dec64_convert_flag cents_flags[8] = {
+        0,
+        DEC64_INEXACT,
+        DEC64_INEXACT,
+        DEC64_INEXACT,
+        DEC64_INEXACT,
+        DEC64_INEXACT,
+        0,
+        DEC64_INEXACT
+    };
+
+    dec64 wide[5];
+    int64 wide_expected[5] = {0, 0, 0, 9000000000000000000, 0};
+    dec64_convert_flag wide_flags[5] = {
+        DEC64_OVERFLOW,
+        DEC64_OVERFLOW,
+        DEC64_OVERFLOW,
+        0,
+        DEC64_OVERFLOW
+    };
+
+    prices[0] = DEC64_ZERO;
+    prices[1] = dec64_new(123450000000, -8);
+    prices[2] = dec64_new(-1, -8);
+    prices[3] = DEC64_ONE;
+    prices[4] = dec64_new(1000000000, -9);
+    prices[5] = dec64_new(-36028797018963968, -8);
+    test_to_integers(
+        "to prices",
+        prices,
+        -8,
+        prices_expected,
+        prices_flags,
+        6
+    );
+
+    cents[0] = DEC64_ZERO;
+    cents[1] = dec64_new(4, -3);
+    cents[2] = dec64_new(5, -3);
+    cents[3] = dec64_new(-5, -3);
+    cents[4] = dec64_new(12350, -4);
+    cents[5] = dec64_new(-12351, -4);
+    cents[6] = dec64_new(123, -2);
+    cents[7] = dec64_new(12300000000000001, -16);
+    test_to_integers(
+        "to cents",
+        cents,
+        -2,
+        cents_expected,
+        cents_flags,
+        8
+    );
+
+    wide[0] = DEC64_NULL;
+    wide[1] = dec64_new(1, 19);
+    wide[2] = dec64_new(-10, 18);
+    wide[3] = dec64_new(9, 18);
+    wide[4] = dec64_new(36028797018963967, 127);
+    test_to_integers(
+        "to wide",
+        wide,
+        0,
+        wide_expected,
+        wide_flags,
+        5
+    );
+}
+
+static void test_all_from_double() {
+    double doubles[4] = {0.5, -1e300, 1e-300, 0.1 + 0.2};
+    dec64 numbers[4];
+    dec64_convert_flag flags[4];
+    double nothing = 0.0;
+
+    test_from_double(0.0, DEC64_ZERO);
+    test_from_double(-0.0, DEC64_ZERO);
+    test_from_double(1.0, DEC64_ONE);
+    test_from_double(-7.25, dec64_new(-725, -2));
+    test_from_double(0.1, dec64_new(1, -1));
+    test_from_double(123.45, dec64_new(12345, -2));
+    test_from_double(0.1 + 0.2, dec64_new(30000000000000004, -17));
+    test_from_double(1.0 / 3.0, dec64_new(3333333333333333, -16));
+    test_from_double(9.5367431640625e-07, dec64_new(95367431640625, -20));
+    test_from_double(1e20, dec64_new(1, 20));
+    test_from_double(1e23, dec64_new(1, 23));
+    test_from_double(1152921504606846976.0, dec64_new(1152921504606847, 3));
+    test_from_double(4503599627370496.0, dec64_new(4503599627370496, 0));
+    test_from_double(36028797018963968.0, dec64_new(3602879701896397, 1));
+    test_from_double(3e143, dec64_new(3, 143));
+    test_from_double(1e-127, dec64_new(1, -127));
+    test_from_double(1.5e-127, dec64_new(2, -127));
+    test_from_double(4e-128, DEC64_ZERO);
+    test_from_double(5e-324, DEC64_ZERO);
+    test_from_double(1e144, DEC64_NULL);
+    test_from_double(1.0 / nothing, DEC64_NULL);
+    test_from_double(-1.0 / nothing, DEC64_NULL);
+    test_from_double(nothing / nothing, DEC64_NULL);
+
+    judge(
+        dec64_from_doubles(doubles, numbers, flags, 4) == 2
+        && numbers[0] == dec64_new(5, -1)
+        && numbers[1] == DEC64_NULL
+        && numbers[2] == DEC64_ZERO
+        && numbers[3] == dec64_new(30000000000000004, -17)
+        && flags[0] == 0
+        && flags[1] == DEC64_OVERFLOW
+        && flags[2] == DEC64_INEXACT
+        && flags[3] == 0,
+        "from doubles",
+        0,
+        numbers[0],
+        0,
+        flags[0]
+    );
+}
+
+static void test_all_to_double() {
+    dec64 numbers[3];
+    double doubles[3];
+
+    test_to_double(DEC64_ZERO, 0.0);
+    test_to_double(DEC64_ONE, 1.0);
+    test_to_double(dec64_new(-725, -2), -7.25);
+    test_to_double(dec64_new(1, -1), 0.1);
+    test_to_double(dec64_new(12345, -2), 123.45);
+    test_to_double(dec64_new(30000000000000004, -17), 0.1 + 0.2);
+    test_to_double(dec64_new(3, -1), 0.3);
+    test_to_double(dec64_new(1, 23), 1e23);
+    test_to_double(dec64_new(841, 19), 8.41e21);
+    test_to_double(dec64_new(5, 22), 5e22);
+    test_to_double(dec64_new(9007199254740993, 0), 9007199254740992.0);
+    test_to_double(dec64_new(9007199254740995, 0), 9007199254740996.0);
+    test_to_double(dec64_new(36028797018963967, 0), 36028797018963968.0);
+    test_to_double(dec64_new(36028797018963967, 127), 3.6028797018963966e143);
+    test_to_double(dec64_new(1, -127), 1e-127);
+    test_to_double(dec64_new(-36028797018963968, -127), -3.6028797018963968e-111);
+    test_to_double(dec64_new(31415926535897932, -16), 3.141592653589793);
+
+    numbers[0] = dec64_new(1, -2);
+    numbers[1] = DEC64_NULL;
+    numbers[2] = dec64_new(25, 1);
+    dec64_to_doubles(numbers, doubles, 3);
+    judge(
+        doubles[0] == 0.01
+        && doubles[1] != doubles[1]
+        && doubles[2] == 250.0,
+        "to doubles",
+        0,
+        numbers[0],
+        0,
+        0
+    );
+}
+
+static int do_tests(int level_of_detail) {
+/*
+    Level of detail:
+        3 full
+        2 errors only
+        1 error summary
+        0 none
+*/
+    level = level_of_detail;
+    nr_fail = 0;
+    nr_pass = 0;
+
+    test_all_from_integers();
+    test_all_to_integers();
+    test_all_from_double();
+    test_all_to_double();
+
+    printf("\n\n%i pass, %i fail.\n", nr_pass, nr_fail);
+    return nr_fail;
+}
+
+int main(int argc, char* argv[]) {
+    return do_tests(2);
+}
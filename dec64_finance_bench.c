@@ -0,0 +1,312 @@
+/* dec64_finance_bench.c
+
+This is a benchmark of dec64.obj and dec64_math.c doing the work that they
+were made for. Where dec64_bench.c measures the operators one at a time, this
+measures small kernels shaped like the loops of financial programs:
+
+    vwap        the volume weighted average price of an order book, the sum of
+                dec64_multiply(price, quantity) divided by the sum of the
+                quantities
+    interest    the balance of each of a set of loans after compounding monthly
+                for some years, with dec64_raise, rounded to cents
+    tax         the tax on each line of a set of invoices, rounded to cents with
+                dec64_round, and the total with tax
+    portfolio   the value of a set of holdings, the sum of
+                dec64_multiply(position, price)
+
+Each kernel is run over generated data, and the result is checked against
+exact integer arithmetic, or against double precision for interest, so that a
+faster but wrong implementation is caught. Each measurement is the median of
+several runs. The results are written as comma separated values:
+
+    kernel,items,ns_per_item,items_per_second,result
+
+The number of items can be given as the first argument.
+
+dec64.com
+2026-10-19
+Public Domain
+
+No warranty.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "dec64.h"
+#include "dec64_math.h"
+#include "dec64_string.h"
+
+#define NR_ITEMS 100000
+#define NR_RUNS 5
+
+/*
+    The generated data. Prices are in cents, quantities and positions are in
+    whole shares, amounts are in cents, and rates are in units of 1e-4.
+*/
+
+static int64 nr_items;
+static dec64* prices;
+static dec64* quantities;
+static dec64* principals;
+static dec64* rates;
+static dec64* months;
+static dec64* amounts;
+static dec64* balances;
+static dec64 tax_rate;
+static volatile dec64 sink;
+static uint64 seed = 0x0123456789ABCDEF;
+static int nr_bad;
+
+static uint64 next() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+static int64 between(int64 low, int64 high) {
+    return low + (int64)(next() % (uint64)(high - low + 1));
+}
+
+static dec64* make_array() {
+    dec64* array = (dec64*)malloc(sizeof(dec64) * nr_items);
+    if (array == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    return array;
+}
+
+static void make_data() {
+    int64 at;
+
+    prices = make_array();
+    quantities = make_array();
+    principals = make_array();
+    rates = make_array();
+    months = make_array();
+    amounts = make_array();
+    balances = make_array();
+    tax_rate = dec64_new(825, -4);
+    for (at = 0; at < nr_items; at += 1) {
+        prices[at] = dec64_new(between(100, 100000), -2);
+        quantities[at] = dec64_new(between(1, 10000), 0);
+        principals[at] = dec64_new(between(100000, 100000000), -2);
+        rates[at] = dec64_new(between(100, 1200), -4);
+        months[at] = dec64_new(12 * between(1, 30), 0);
+        amounts[at] = dec64_new(between(1, 1000000), -2);
+    }
+}
+
+/* kernels */
+
+static dec64 vwap() {
+    int64 at;
+    dec64 notional = DEC64_ZERO;
+    dec64 volume = DEC64_ZERO;
+
+    for (at = 0; at < nr_items; at += 1) {
+        notional = dec64_add(notional, dec64_multiply(prices[at], quantities[at]));
+        volume = dec64_add(volume, quantities[at]);
+    }
+    return dec64_divide(notional, volume);
+}
+
+static dec64 interest() {
+/*
+    balance = principal * (1 + rate / 12) ** months, to the cent.
+*/
+    int64 at;
+    dec64 cents = dec64_new(-2, 0);
+    dec64 total = DEC64_ZERO;
+    dec64 twelve = dec64_new(12, 0);
+
+    for (at = 0; at < nr_items; at += 1) {
+        balances[at] = dec64_round(
+            dec64_multiply(
+                principals[at],
+                dec64_raise(
+                    dec64_add(DEC64_ONE, dec64_divide(rates[at], twelve)),
+                    months[at]
+                )
+            ),
+            cents
+        );
+        total = dec64_add(total, balances[at]);
+    }
+    return total;
+}
+
+static dec64 tax() {
+    int64 at;
+    dec64 cents = dec64_new(-2, 0);
+    dec64 total = DEC64_ZERO;
+
+    for (at = 0; at < nr_items; at += 1) {
+        total = dec64_add(
+            total,
+            dec64_add(
+                amounts[at],
+                dec64_round(dec64_multiply(amounts[at], tax_rate), cents)
+            )
+        );
+    }
+    return total;
+}
+
+static dec64 portfolio() {
+    int64 at;
+    dec64 value = DEC64_ZERO;
+
+    for (at = 0; at < nr_items; at += 1) {
+        value = dec64_add(value, dec64_multiply(quantities[at], prices[at]));
+    }
+    return value;
+}
+
+/* checks */
+
+static void judge(int ok, char* kernel_name) {
+    if (!ok) {
+        fprintf(stderr, "%s: the result is wrong.\n", kernel_name);
+        nr_bad += 1;
+    }
+}
+
+static double to_double(dec64 number) {
+    return (double)dec64_coefficient(number) * pow(10, (double)dec64_exponent(number));
+}
+
+static void check_results() {
+/*
+    The sums of cents are small enough to be exact in an int64, so vwap's
+    notional, tax, and portfolio can be checked exactly. Interest goes through
+    dec64_raise, so it is checked against double precision.
+*/
+    int64 at;
+    double balance;
+    int64 cents;
+    int64 notional = 0;
+    int64 total = 0;
+    int64 volume = 0;
+    dec64 result;
+
+    for (at = 0; at < nr_items; at += 1) {
+        notional += dec64_coefficient(prices[at]) * dec64_coefficient(quantities[at]);
+        volume += dec64_coefficient(quantities[at]);
+    }
+    result = vwap();
+
+/*
+    The average can be off by a unit in its last place, which is multiplied by
+    the volume.
+*/
+
+    judge(
+        dec64_is_less(
+            dec64_abs(dec64_subtract(
+                dec64_multiply(result, dec64_new(volume, 0)),
+                dec64_new(notional, -2)
+            )),
+            dec64_new(volume, dec64_exponent(result))
+        ) == DEC64_TRUE,
+        "vwap"
+    );
+    judge(dec64_is_equal(portfolio(), dec64_new(notional, -2)) == DEC64_TRUE, "portfolio");
+    for (at = 0; at < nr_items; at += 1) {
+        cents = dec64_coefficient(amounts[at]);
+        total += cents + (cents * 825 + 5000) / 10000;
+    }
+    judge(dec64_is_equal(tax(), dec64_new(total, -2)) == DEC64_TRUE, "tax");
+    interest();
+    for (at = 0; at < nr_items; at += 1) {
+        balance = to_double(principals[at]) * pow(
+            1 + to_double(rates[at]) / 12,
+            to_double(months[at])
+        );
+        if (fabs(to_double(balances[at]) - balance) > 0.005 + balance * 1e-12) {
+            judge(0, "interest");
+            break;
+        }
+    }
+}
+
+/* measurement */
+
+static double now() {
+/*
+    The time in nanoseconds.
+*/
+    struct timespec time;
+
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+static void report(
+    dec64_string_state state,
+    char* kernel_name,
+    dec64 (*kernel)()
+) {
+/*
+    Take the median of the runs, and write a line.
+*/
+    dec64_string_char buffer[64];
+    double ns;
+    dec64 result = DEC64_NULL;
+    double runs[NR_RUNS];
+    int run_nr;
+    double start;
+
+    for (run_nr = 0; run_nr < NR_RUNS; run_nr += 1) {
+        start = now();
+        result = kernel();
+        runs[run_nr] = now() - start;
+    }
+    sink = result;
+    qsort(runs, NR_RUNS, sizeof(double), compare_doubles);
+    ns = runs[NR_RUNS / 2];
+    if (ns <= 0) {
+        ns = 1;
+    }
+    dec64_to_string(state, result, buffer);
+    printf(
+        "%s,%lli,%.3f,%.0f,%s\n",
+        kernel_name,
+        nr_items,
+        ns / (double)nr_items,
+        (double)nr_items * 1e9 / ns,
+        buffer
+    );
+}
+
+int main(int argc, char* argv[]) {
+    dec64_string_state state;
+
+    nr_items = NR_ITEMS;
+    if (argc > 1) {
+        nr_items = atoll(argv[1]);
+        if (nr_items <= 0) {
+            nr_items = NR_ITEMS;
+        }
+    }
+    make_data();
+    check_results();
+    state = dec64_string_begin();
+    dec64_string_places(state, 2);
+    printf("kernel,items,ns_per_item,items_per_second,result\n");
+    report(state, "vwap", vwap);
+    report(state, "interest", interest);
+    report(state, "tax", tax);
+    report(state, "portfolio", portfolio);
+    dec64_string_end(state);
+    return nr_bad != 0;
+}
@@ -0,0 +1,478 @@
+/* dec64_fuzz.c
+
+This is a differential test of the implementations of dec64.h: dec64.asm for
+x64, dec64.s for ARM64, and dec64.v.s for RISC-V. They are separate ports, so
+they can disagree without any of the tests noticing. Only one of them can be
+linked into a program, so this program is built once against each, and the
+builds are compared through a trace file.
+
+    dec64_fuzz write [count] [seed] > trace
+
+writes a trace of every operator in dec64.h applied to edge cases and to
+count random operands. Each line holds the operator, the operands, and the
+result, in hexadecimal. This is 123.45 + 1:
+
+    add 00000000003039FE 0000000000000100 0000000000309DFE
+
+    dec64_fuzz check trace
+
+recomputes every line of a trace and reports each result that is not
+bit-for-bit identical. The exit status is 1 if there were any. A trace can
+be made on one machine and checked on another, or under qemu-user:
+
+    qemu-aarch64 ./dec64_fuzz check trace
+
+Both modes also check the laws that every implementation must obey: a nan
+result is always DEC64_NULL, a comparison is always DEC64_TRUE or
+DEC64_FALSE, add, multiply and is_equal are commutative, and the results that
+dec64.asm promises to be zero or nan for all n are.
+
+A build for an implementation that lacks dec64_inc and dec64_dec can define
+DEC64_FUZZ_NO_INC_DEC. Those lines of a trace are then skipped.
+
+If compiled with DEC64_FUZZ_LIBFUZZER, there is no main, and instead the
+laws are checked for each input of a coverage guided fuzzer like libFuzzer:
+
+    clang -fsanitize=fuzzer -DDEC64_FUZZ_LIBFUZZER dec64_fuzz.c dec64.o
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dec64.h"
+
+#define NR_RANDOM 1000000
+#define LINE_SIZE 256
+
+typedef dec64 (*unary)(dec64);
+typedef dec64 (*binary)(dec64, dec64);
+
+struct operator {
+    char* name;
+    unary unary_function;
+    binary binary_function;
+};
+
+static struct operator operators[] = {
+    {"abs", dec64_abs, NULL},
+    {"add", NULL, dec64_add},
+    {"ceiling", dec64_ceiling, NULL},
+    {"coefficient", dec64_coefficient, NULL},
+#ifndef DEC64_FUZZ_NO_INC_DEC
+    {"dec", dec64_dec, NULL},
+#endif
+    {"divide", NULL, dec64_divide},
+    {"exponent", dec64_exponent, NULL},
+    {"floor", dec64_floor, NULL},
+#ifndef DEC64_FUZZ_NO_INC_DEC
+    {"inc", dec64_inc, NULL},
+#endif
+    {"integer_divide", NULL, dec64_integer_divide},
+    {"is_equal", NULL, dec64_is_equal},
+    {"is_false", dec64_is_false, NULL},
+    {"is_integer", dec64_is_integer, NULL},
+    {"is_less", NULL, dec64_is_less},
+    {"is_nan", dec64_is_nan, NULL},
+    {"is_zero", dec64_is_zero, NULL},
+    {"modulo", NULL, dec64_modulo},
+    {"multiply", NULL, dec64_multiply},
+    {"neg", dec64_neg, NULL},
+    {"new", NULL, dec64_new},
+    {"normal", dec64_normal, NULL},
+    {"round", NULL, dec64_round},
+    {"signum", dec64_signum, NULL},
+    {"subtract", NULL, dec64_subtract}
+};
+
+#define NR_OPERATORS ((int)(sizeof(operators) / sizeof(operators[0])))
+
+static int64 nr_failed;
+
+/* the laws */
+
+static int is_comparison(char* name) {
+    return strncmp(name, "is_", 3) == 0;
+}
+
+static void fail(
+    char* name,
+    dec64 first,
+    dec64 second,
+    dec64 expected,
+    dec64 actual,
+    char* why
+) {
+    nr_failed += 1;
+    if (nr_failed <= 100) {
+        fprintf(
+            stderr,
+            "FAIL %s %016llX %016llX expected %016llX actual %016llX %s\n",
+            name,
+            (uint64)first,
+            (uint64)second,
+            (uint64)expected,
+            (uint64)actual,
+            why
+        );
+    }
+}
+
+static void check_laws(struct operator* op, dec64 first, dec64 second, dec64 result) {
+    char* name = op->name;
+
+    if (
+        strcmp(name, "coefficient") != 0
+        && strcmp(name, "exponent") != 0
+        && !is_comparison(name)
+        && (result & 0xFF) == 0x80
+        && result != DEC64_NULL
+    ) {
+        fail(name, first, second, DEC64_NULL, result, "nan is not DEC64_NULL");
+    }
+    if (is_comparison(name) && result != DEC64_TRUE && result != DEC64_FALSE) {
+        fail(name, first, second, DEC64_TRUE, result, "not a boolean");
+    }
+    if (
+        strcmp(name, "add") == 0
+        || strcmp(name, "multiply") == 0
+        || strcmp(name, "is_equal") == 0
+    ) {
+        dec64 swapped = op->binary_function(second, first);
+        if (swapped != result) {
+            fail(name, first, second, swapped, result, "not commutative");
+        }
+    }
+    if (
+        dec64_is_zero(first) == DEC64_TRUE
+        && (
+            strcmp(name, "divide") == 0
+            || strcmp(name, "integer_divide") == 0
+            || strcmp(name, "modulo") == 0
+            || strcmp(name, "multiply") == 0
+        )
+        && result != DEC64_ZERO
+    ) {
+        fail(name, first, second, DEC64_ZERO, result, "0 op n is not 0");
+    }
+}
+
+static dec64 apply(struct operator* op, dec64 first, dec64 second) {
+    dec64 result = (
+        op->unary_function != NULL
+        ? op->unary_function(first)
+        : op->binary_function(first, second)
+    );
+
+    if (strcmp(op->name, "new") != 0) {
+        check_laws(op, first, second, result);
+    }
+    return result;
+}
+
+#ifdef DEC64_FUZZ_LIBFUZZER
+
+int LLVMFuzzerTestOneInput(const unsigned char* data, size_t size) {
+/*
+    The first byte selects the operator, and the next 16 are the operands. The
+    place of a round is kept small, as in random_place.
+*/
+    dec64 first = 0;
+    dec64 second = 0;
+    struct operator* op;
+
+    if (size < 17) {
+        return 0;
+    }
+    op = &operators[data[0] % NR_OPERATORS];
+    memcpy(&first, data + 1, 8);
+    memcpy(&second, data + 9, 8);
+    if (strcmp(op->name, "round") == 0) {
+        second = dec64_new((int64)(data[9] % 41) - 20, 0);
+    }
+    apply(op, first, second);
+    if (nr_failed != 0) {
+        abort();
+    }
+    return 0;
+}
+
+#else
+
+/*
+    The edge cases are the numbers at which the implementations change paths:
+    zero and the nans, the extreme coefficients and exponents, the powers of
+    ten at which a coefficient gains a digit, and the numbers near them.
+*/
+
+static dec64 edges[64];
+static int nr_edges;
+
+static int64 nr_checked;
+static int64 nr_skipped;
+
+static void add_edge(int64 coefficient, int64 exponent) {
+    edges[nr_edges] = (dec64)(((uint64)coefficient << 8) | (uint64)(exponent & 0xFF));
+    nr_edges += 1;
+}
+
+static void define_edges() {
+    nr_edges = 0;
+    add_edge(0, 0);
+    add_edge(0, 5);
+    add_edge(0, -128);
+    add_edge(1, -128);
+    add_edge(1, 0);
+    add_edge(-1, 0);
+    add_edge(2, 0);
+    add_edge(1, -1);
+    add_edge(5, -1);
+    add_edge(-5, -1);
+    add_edge(15, -1);
+    add_edge(10, 0);
+    add_edge(1, 127);
+    add_edge(-1, 127);
+    add_edge(1, -127);
+    add_edge(-1, -127);
+    add_edge(36028797018963967, 0);
+    add_edge(-36028797018963968, 0);
+    add_edge(36028797018963967, 127);
+    add_edge(-36028797018963968, 127);
+    add_edge(36028797018963967, -127);
+    add_edge(-36028797018963968, -127);
+    add_edge(3602879701896396, 1);
+    add_edge(10000000000000000, 0);
+    add_edge(9999999999999999, 0);
+    add_edge(10000000000000000, -16);
+    add_edge(-10000000000000000, -16);
+    add_edge(314159265358979, -14);
+    add_edge(-271828182845905, -14);
+    add_edge(12345, -2);
+    add_edge(-12345, -2);
+    add_edge(1, 17);
+    add_edge(1, -17);
+    add_edge(7, 100);
+    add_edge(-7, -100);
+    add_edge(25, -1);
+    add_edge(-25, -1);
+    add_edge(35, -1);
+}
+
+/* the random operands */
+
+static uint64 seed = 0x0123456789ABCDEF;
+
+static uint64 next() {
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+static dec64 random_operand() {
+/*
+    Most operands are a coefficient of a random number of bits with an
+    exponent near 0, because that is where the paths are. Some are an edge,
+    some have any exponent, and some are any 64 bits at all.
+*/
+    uint64 bits = next();
+    int64 coefficient;
+    int64 exponent;
+
+    switch (bits & 7) {
+    case 0:
+        return edges[(bits >> 3) % (uint64)nr_edges];
+    case 1:
+        return (dec64)next();
+    case 2:
+        exponent = (int64)(signed char)(bits >> 8);
+        break;
+    default:
+        exponent = (int64)((bits >> 8) % 41) - 20;
+        break;
+    }
+    coefficient = (int64)(next() >> (9 + (bits >> 16) % 55));
+    if ((bits >> 24) & 1) {
+        coefficient = -coefficient;
+    }
+    return (dec64)(((uint64)coefficient << 8) | (uint64)(exponent & 0xFF));
+}
+
+static int64 random_new_operand(int first) {
+/*
+    dec64_new takes integers, not dec64s, so its operands are a coefficient of
+    any size and an exponent that is usually in range.
+*/
+    uint64 bits = next();
+
+    if (first) {
+        return (int64)(next() >> (bits % 64));
+    }
+    return (int64)(bits % 300) - 150;
+}
+
+static dec64 random_place() {
+/*
+    dec64_round takes as long as the distance between the exponent and the
+    place, so the place is kept between -20 and 20, a little beyond the -16
+    thru 16 that dec64.asm asks for.
+*/
+    return dec64_new((int64)(next() % 41) - 20, 0);
+}
+
+/* writing */
+
+static void write_line(struct operator* op, dec64 first, dec64 second) {
+    printf(
+        "%s %016llX %016llX %016llX\n",
+        op->name,
+        (uint64)first,
+        (uint64)second,
+        (uint64)apply(op, first, second)
+    );
+}
+
+static void write_trace(int64 nr_random) {
+    int64 at;
+    int first_nr;
+    int op_nr;
+    int second_nr;
+
+    for (op_nr = 0; op_nr < NR_OPERATORS; op_nr += 1) {
+        struct operator* op = &operators[op_nr];
+        if (strcmp(op->name, "new") == 0) {
+            for (at = 0; at < 1000; at += 1) {
+                dec64 coefficient = random_new_operand(1);
+                write_line(op, coefficient, random_new_operand(0));
+            }
+        } else if (strcmp(op->name, "round") == 0) {
+            for (first_nr = 0; first_nr < nr_edges; first_nr += 1) {
+                for (at = -20; at <= 20; at += 1) {
+                    write_line(op, edges[first_nr], dec64_new(at, 0));
+                }
+            }
+        } else if (op->unary_function != NULL) {
+            for (first_nr = 0; first_nr < nr_edges; first_nr += 1) {
+                write_line(op, edges[first_nr], DEC64_ZERO);
+            }
+        } else {
+            for (first_nr = 0; first_nr < nr_edges; first_nr += 1) {
+                for (second_nr = 0; second_nr < nr_edges; second_nr += 1) {
+                    write_line(op, edges[first_nr], edges[second_nr]);
+                }
+            }
+        }
+    }
+    for (at = 0; at < nr_random; at += 1) {
+        struct operator* op = &operators[next() % (uint64)NR_OPERATORS];
+        if (strcmp(op->name, "new") == 0) {
+            dec64 coefficient = random_new_operand(1);
+            write_line(op, coefficient, random_new_operand(0));
+        } else if (strcmp(op->name, "round") == 0) {
+            dec64 number = random_operand();
+            write_line(op, number, random_place());
+        } else {
+            dec64 first = random_operand();
+            write_line(
+                op,
+                first,
+                op->unary_function != NULL
+                ? DEC64_ZERO
+                : random_operand()
+            );
+        }
+    }
+}
+
+/* checking */
+
+static struct operator* find_operator(char* name) {
+    int op_nr;
+
+    for (op_nr = 0; op_nr < NR_OPERATORS; op_nr += 1) {
+        if (strcmp(operators[op_nr].name, name) == 0) {
+            return &operators[op_nr];
+        }
+    }
+    return NULL;
+}
+
+static int check_trace(FILE* file) {
+    char line[LINE_SIZE];
+    char name[LINE_SIZE];
+    uint64 first;
+    uint64 second;
+    uint64 expected;
+
+    while (fgets(line, LINE_SIZE, file) != NULL) {
+        struct operator* op;
+        dec64 actual;
+        if (
+            sscanf(line, "%255s %llx %llx %llx", name, &first, &second, &expected)
+            != 4
+        ) {
+            continue;
+        }
+        op = find_operator(name);
+        if (op == NULL) {
+            nr_skipped += 1;
+            continue;
+        }
+        nr_checked += 1;
+        actual = apply(op, (dec64)first, (dec64)second);
+        if (actual != (dec64)expected) {
+            fail(name, first, second, expected, actual, "differs");
+        }
+    }
+    fprintf(
+        stderr,
+        "%lld checked, %lld failed, %lld skipped.\n",
+        nr_checked,
+        nr_failed,
+        nr_skipped
+    );
+    return nr_failed != 0;
+}
+
+int main(int argc, char* argv[]) {
+    FILE* file;
+    int result;
+    int64 nr_random = NR_RANDOM;
+
+    define_edges();
+    if (argc > 1 && strcmp(argv[1], "write") == 0) {
+        if (argc > 2) {
+            nr_random = atoll(argv[2]);
+        }
+        if (argc > 3) {
+            seed = strtoull(argv[3], NULL, 0);
+            if (seed == 0) {
+                seed = 1;
+            }
+        }
+        write_trace(nr_random);
+        if (nr_failed != 0) {
+            fprintf(stderr, "%lld laws broken.\n", nr_failed);
+        }
+        return nr_failed != 0;
+    }
+    if (argc > 2 && strcmp(argv[1], "check") == 0) {
+        file = fopen(argv[2], "r");
+        if (file == NULL) {
+            fprintf(stderr, "Can not open %s.\n", argv[2]);
+            return 2;
+        }
+        result = check_trace(file);
+        fclose(file);
+        return result;
+    }
+    fprintf(stderr, "usage: dec64_fuzz write [count] [seed]\n       dec64_fuzz check trace\n");
+    return 2;
+}
+
+#endif
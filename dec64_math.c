@@ -3,29 +3,33 @@ dec64_math.c
 Elementary functions for DEC64.
 
 dec64.com
-2022-09-07
+2026-10-18
 Public Domain
 
 No warranty.
-
-This file is a placeholder. It should be replaced with functions that are
-faster and more accurate.
 */
 
-#include <stdlib.h>
+#include <math.h>
 #include <stdlib.h>
 #include "dec64.h"
 #include "dec64_math.h"
 
 #define D_E              0x6092A113D8D574F0LL
-#define D_HALF                        0x5FFLL
-#define D_HALF_PI        0x37CE4F32BB21A6F0LL
-#define D_NHALF_PI       0xC831B0CD44DE59F0LL
-#define D_NPI            0x9063619A89BCB4F0LL
-#define D_PI             0x6F9C9E6576434CF0LL
 #define D_2PI            0x165286144ADA42F1LL
 
+#define D_EXP_MAX                 0x19000LL
+
+#define CONFIRMED        ((int64)0xFFDEADFACEC0DECELL)
+
 #define FAC              93
+#define REDUCE_LIMBS     10
+
+#ifdef DEC64_MATH_COUNT
+int64 dec64_math_counts[DEC64_MATH_COUNTS];
+#define COUNT(kind, n) (dec64_math_counts[kind] += (n))
+#else
+#define COUNT(kind, n)
+#endif
 
 dec64 factorials[FAC] = {
     (1LL << 8) + 0,
@@ -123,370 +127,2913 @@ dec64 factorials[FAC] = {
     (12438414054641307LL << 8) + 126
 };
 
-dec64 dec64_acos(dec64 slope) {
-    dec64 result = dec64_subtract(
-        D_HALF_PI,
-        dec64_asin(slope)
+static const int64 power[19] = {
+    1,
+    10,
+    100,
+    1000,
+    10000,
+    100000,
+    1000000,
+    10000000,
+    100000000,
+    1000000000,
+    10000000000,
+    100000000000,
+    1000000000000,
+    10000000000000,
+    100000000000000,
+    1000000000000000,
+    10000000000000000,
+    100000000000000000,
+    1000000000000000000
+};
+
+/*
+    The elementary functions are computed in fixed point. A fixed is a 128 bit
+    two's complement number in two words, with 112 bits of fraction. That is
+    more than 33 digits, so a result can be correctly rounded to a dec64 just
+    once, at the end. The range is a little more than -32768 thru 32767.
+*/
+
+typedef struct fixed {
+    uint64 high;
+    uint64 low;
+} fixed;
+
+static const fixed fixed_zero = {0x0000000000000000ULL, 0x0000000000000000ULL};
+static const fixed fixed_one = {0x0001000000000000ULL, 0x0000000000000000ULL};
+static const fixed fixed_ln10 = {0x00024D763776AAA2ULL, 0xB05BA95B58AE0B4CULL};
+static const fixed fixed_half = {0x0000800000000000ULL, 0x0000000000000000ULL};
+static const fixed fixed_half_pi = {0x0001921FB54442D1ULL, 0x8469898CC51701B8ULL};
+static const fixed fixed_pi = {0x0003243F6A8885A3ULL, 0x08D313198A2E0370ULL};
+static const fixed fixed_ln2 = {0x0000B17217F7D1CFULL, 0x79ABC9E3B39803F3ULL};
+static const fixed fixed_log10_e = {0x00006F2DEC549B94ULL, 0x38CA9AADD557D69AULL};
+static const fixed fixed_log2_e = {0x000171547652B82FULL, 0xE1777D0FFDA0D23AULL};
+static const fixed fixed_half_log_2pi = {0x0000EB3F8E4325F5ULL, 0xA53494BC90014419ULL};
+static const fixed fixed_log_pi = {0x0001250D048E7A1BULL, 0xD0BD5F956C6A843FULL};
+static const fixed fixed_euler = {0x000093C467E37DB0ULL, 0xC7A4D1BE3F810153ULL};
+
+/*
+    The series are evaluated as polynomials with these coefficients, so that
+    Horner's method takes only multiplications.
+*/
+
+static const fixed fixed_exp_coefficients[15] = {
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 1/0! */
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 1/1! */
+    {0x0000800000000000ULL, 0x0000000000000000ULL},  /* 1/2! */
+    {0x00002AAAAAAAAAAAULL, 0xAAAAAAAAAAAAAAABULL},  /* 1/3! */
+    {0x00000AAAAAAAAAAAULL, 0xAAAAAAAAAAAAAAABULL},  /* 1/4! */
+    {0x0000022222222222ULL, 0x2222222222222222ULL},  /* 1/5! */
+    {0x0000005B05B05B05ULL, 0xB05B05B05B05B05BULL},  /* 1/6! */
+    {0x0000000D00D00D00ULL, 0xD00D00D00D00D00DULL},  /* 1/7! */
+    {0x00000001A01A01A0ULL, 0x1A01A01A01A01A02ULL},  /* 1/8! */
+    {0x000000002E3BC74AULL, 0xAD8E671F5583911DULL},  /* 1/9! */
+    {0x00000000049F93EDULL, 0xDE27D71CBBC05B50ULL},  /* 1/10! */
+    {0x00000000006B9915ULL, 0x9FD5138E3F9D1F93ULL},  /* 1/11! */
+    {0x000000000008F76CULL, 0x77FC6C4BDAA26D4CULL},  /* 1/12! */
+    {0x000000000000B092ULL, 0x309D43684BE51C1AULL},  /* 1/13! */
+    {0x0000000000000C9CULL, 0xBA54603E4E905D70ULL}   /* 1/14! */
+};
+
+static const fixed fixed_log_coefficients[18] = {
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 1/1 */
+    {0xFFFF800000000000ULL, 0x0000000000000000ULL},  /* -1/2 */
+    {0x0000555555555555ULL, 0x5555555555555555ULL},  /* 1/3 */
+    {0xFFFFC00000000000ULL, 0x0000000000000000ULL},  /* -1/4 */
+    {0x0000333333333333ULL, 0x3333333333333333ULL},  /* 1/5 */
+    {0xFFFFD55555555555ULL, 0x5555555555555555ULL},  /* -1/6 */
+    {0x0000249249249249ULL, 0x2492492492492492ULL},  /* 1/7 */
+    {0xFFFFE00000000000ULL, 0x0000000000000000ULL},  /* -1/8 */
+    {0x00001C71C71C71C7ULL, 0x1C71C71C71C71C72ULL},  /* 1/9 */
+    {0xFFFFE66666666666ULL, 0x6666666666666666ULL},  /* -1/10 */
+    {0x00001745D1745D17ULL, 0x45D1745D1745D174ULL},  /* 1/11 */
+    {0xFFFFEAAAAAAAAAAAULL, 0xAAAAAAAAAAAAAAABULL},  /* -1/12 */
+    {0x000013B13B13B13BULL, 0x13B13B13B13B13B1ULL},  /* 1/13 */
+    {0xFFFFEDB6DB6DB6DBULL, 0x6DB6DB6DB6DB6DB7ULL},  /* -1/14 */
+    {0x0000111111111111ULL, 0x1111111111111111ULL},  /* 1/15 */
+    {0xFFFFF00000000000ULL, 0x0000000000000000ULL},  /* -1/16 */
+    {0x00000F0F0F0F0F0FULL, 0x0F0F0F0F0F0F0F0FULL},  /* 1/17 */
+    {0xFFFFF1C71C71C71CULL, 0x71C71C71C71C71C7ULL}   /* -1/18 */
+};
+
+static const fixed fixed_sine_coefficients[14] = {
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 1/1! */
+    {0xFFFFD55555555555ULL, 0x5555555555555555ULL},  /* -1/3! */
+    {0x0000022222222222ULL, 0x2222222222222222ULL},  /* 1/5! */
+    {0xFFFFFFF2FF2FF2FFULL, 0x2FF2FF2FF2FF2FF3ULL},  /* -1/7! */
+    {0x000000002E3BC74AULL, 0xAD8E671F5583911DULL},  /* 1/9! */
+    {0xFFFFFFFFFF9466EAULL, 0x602AEC71C062E06DULL},  /* -1/11! */
+    {0x000000000000B092ULL, 0x309D43684BE51C1AULL},  /* 1/13! */
+    {0xFFFFFFFFFFFFFF28ULL, 0xC060C6623F07713DULL},  /* -1/15! */
+    {0x0000000000000000ULL, 0xCA963B81856A5359ULL},  /* 1/17! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xFF685B25CBF5F547ULL},  /* -1/19! */
+    {0x0000000000000000ULL, 0x00005C6E3BDB73D6ULL},  /* 1/21! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFD13C97D9D4ULL},  /* -1/23! */
+    {0x0000000000000000ULL, 0x0000000013F3CCDDULL},  /* 1/25! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFF8B954ULL}   /* -1/27! */
+};
+
+static const fixed fixed_cosine_coefficients[15] = {
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 1/0! */
+    {0xFFFF800000000000ULL, 0x0000000000000000ULL},  /* -1/2! */
+    {0x00000AAAAAAAAAAAULL, 0xAAAAAAAAAAAAAAABULL},  /* 1/4! */
+    {0xFFFFFFA4FA4FA4FAULL, 0x4FA4FA4FA4FA4FA5ULL},  /* -1/6! */
+    {0x00000001A01A01A0ULL, 0x1A01A01A01A01A02ULL},  /* 1/8! */
+    {0xFFFFFFFFFB606C12ULL, 0x21D828E3443FA4B0ULL},  /* -1/10! */
+    {0x000000000008F76CULL, 0x77FC6C4BDAA26D4CULL},  /* 1/12! */
+    {0xFFFFFFFFFFFFF363ULL, 0x45AB9FC1B16FA290ULL},  /* -1/14! */
+    {0x000000000000000DULL, 0x73F9F399DC0F88ECULL},  /* 1/16! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xF4BEC3CE23413442ULL},  /* -1/18! */
+    {0x0000000000000000ULL, 0x0007950AE9008089ULL},  /* 1/20! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xFFFFFBCC71A49202ULL},  /* -1/22! */
+    {0x0000000000000000ULL, 0x00000001F2CF0197ULL},  /* 1/24! */
+    {0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFF3B8BD0ULL},  /* -1/26! */
+    {0x0000000000000000ULL, 0x0000000000004286ULL}   /* 1/28! */
+};
+
+static const fixed fixed_stirling_coefficients[13] = {
+    {0x0000155555555555ULL, 0x5555555555555555ULL},  /* 1/12 */
+    {0xFFFFFF49F49F49F4ULL, 0x9F49F49F49F49F4AULL},  /* -1/360 */
+    {0x0000003403403403ULL, 0x4034034034034034ULL},  /* 1/1260 */
+    {0xFFFFFFD8FD8FD8FDULL, 0x8FD8FD8FD8FD8FD9ULL},  /* -1/1680 */
+    {0x000000372A3C5631ULL, 0xFE46AE1D4E700DCBULL},  /* 1/1188 */
+    {0xFFFFFF82553C999BULL, 0x0E0DF82553C999B1ULL},  /* -691/360360 */
+    {0x000001A41A41A41AULL, 0x41A41A41A41A41A4ULL},  /* 1/156 */
+    {0xFFFFF86F5E4D3C2BULL, 0x1A08F7E6D5C4B3A3ULL},  /* -3617/122400 */
+    {0x00002DFD2C703C0CULL, 0xFFF430EDFD2C703CULL},  /* 43867/244188 */
+    {0xFFFE9B898FEE7E0CULL, 0x6124246319DA6783ULL},  /* -174611/125400 */
+    {0x000D672219167002ULL, 0xD3A7A9C886459C01ULL},  /* 77683/5796 */
+    {0xFF6326D6D1999F2AULL, 0xA4C08ED1461F835CULL},  /* -236364091/1506960 */
+    {0x08911A740DA740DAULL, 0x740DA740DA740DA7ULL}   /* 657931/300 */
+};
+
+static const fixed fixed_exp_eighths[19] = {
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* e**(0/8) */
+    {0x00012216045B6F5CULL, 0xCF9CED688384E06CULL},  /* e**(1/8) */
+    {0x000148B5E3C3E818ULL, 0x66767BC3B69BAABEULL},  /* e**(2/8) */
+    {0x0001747A513DBEF6ULL, 0xA623478B659B0924ULL},  /* e**(3/8) */
+    {0x0001A61298E1E069ULL, 0xBC972DFEFAB6DF34ULL},  /* e**(4/8) */
+    {0x0001DE455DF80E3CULL, 0x05CA897B072F6DAAULL},  /* e**(5/8) */
+    {0x00021DF3B68CFB9EULL, 0xF7A986ADDC7DCEE2ULL},  /* e**(6/8) */
+    {0x0002661CB0F6C564ULL, 0xF38443FEAF672144ULL},  /* e**(7/8) */
+    {0x0002B7E151628AEDULL, 0x2A6ABF7158809CF5ULL},  /* e**(8/8) */
+    {0x000314891766B0EDULL, 0x0E3E661D5353DE3BULL},  /* e**(9/8) */
+    {0x00037D871DB61F5DULL, 0xFCAEA9E08A299CCBULL},  /* e**(10/8) */
+    {0x0003F47FE87A1D5FULL, 0x19A0D2DAC7AD2964ULL},  /* e**(11/8) */
+    {0x00047B4FF993F150ULL, 0x55F6E4658D43E9DEULL},  /* e**(12/8) */
+    {0x000514134520127FULL, 0x660EE92DC97A9788ULL},  /* e**(13/8) */
+    {0x0005C12DA416EB2FULL, 0xAB7E8026F762A866ULL},  /* e**(14/8) */
+    {0x0006855466E0F306ULL, 0xC77840907E7A69B2ULL},  /* e**(15/8) */
+    {0x000763992E35376BULL, 0x730CE8EE881ADA2BULL},  /* e**(16/8) */
+    {0x00085F7635B44463ULL, 0xF17EFA0E17757F52ULL},  /* e**(17/8) */
+    {0x00097CDC417A3F40ULL, 0x5A65732B338B50F6ULL}   /* e**(18/8) */
+};
+
+/*
+    The log tables are indexed by j + 4, where -4 <= j <= 9.
+*/
+
+static const fixed fixed_log_reciprocal[14] = {
+    {0x0001555555555555ULL, 0x5555555555555555ULL},  /* 16/12 */
+    {0x00013B13B13B13B1ULL, 0x3B13B13B13B13B14ULL},  /* 16/13 */
+    {0x0001249249249249ULL, 0x2492492492492492ULL},  /* 16/14 */
+    {0x0001111111111111ULL, 0x1111111111111111ULL},  /* 16/15 */
+    {0x0001000000000000ULL, 0x0000000000000000ULL},  /* 16/16 */
+    {0x0000F0F0F0F0F0F0ULL, 0xF0F0F0F0F0F0F0F1ULL},  /* 16/17 */
+    {0x0000E38E38E38E38ULL, 0xE38E38E38E38E38EULL},  /* 16/18 */
+    {0x0000D79435E50D79ULL, 0x435E50D79435E50DULL},  /* 16/19 */
+    {0x0000CCCCCCCCCCCCULL, 0xCCCCCCCCCCCCCCCDULL},  /* 16/20 */
+    {0x0000C30C30C30C30ULL, 0xC30C30C30C30C30CULL},  /* 16/21 */
+    {0x0000BA2E8BA2E8BAULL, 0x2E8BA2E8BA2E8BA3ULL},  /* 16/22 */
+    {0x0000B21642C8590BULL, 0x21642C8590B21643ULL},  /* 16/23 */
+    {0x0000AAAAAAAAAAAAULL, 0xAAAAAAAAAAAAAAABULL},  /* 16/24 */
+    {0x0000A3D70A3D70A3ULL, 0xD70A3D70A3D70A3DULL}   /* 16/25 */
+};
+
+static const fixed fixed_log_sixteenths[14] = {
+    {0xFFFFB65A77BB2C91ULL, 0xB61F10522624FD56ULL},  /* ln(12/16) */
+    {0xFFFFCAD82586EA4CULL, 0x3921A82B10B46FE4ULL},  /* ln(13/16) */
+    {0xFFFFDDD0E2FBB037ULL, 0x084398E97C071A43ULL},  /* ln(14/16) */
+    {0xFFFFEF7A674A61C5ULL, 0xF9775C02640AFCC9ULL},  /* ln(15/16) */
+    {0x0000000000000000ULL, 0x0000000000000000ULL},  /* ln(16/16) */
+    {0x00000F85186008B1ULL, 0x5330BE64B8B77599ULL},  /* ln(17/16) */
+    {0x00001E27076E2AF2ULL, 0xE5E9EA87FFE1FE9EULL},  /* ln(18/16) */
+    {0x00002BFE60E14F27ULL, 0xA790E7C4140E4247ULL},  /* ln(19/16) */
+    {0x0000391FEF8F3534ULL, 0x43584BB03DE5FF73ULL},  /* ln(20/16) */
+    {0x0000459D72AEAE98ULL, 0x380E731F55C41B8CULL},  /* ln(21/16) */
+    {0x000051862F08717BULL, 0x09F42DECDECCF1CDULL},  /* ln(22/16) */
+    {0x00005CE75FDAEF40ULL, 0x1A7389314FEB4FBEULL},  /* ln(23/16) */
+    {0x000067CC8FB2FE61ULL, 0x2FCADA35D9BD0149ULL},  /* ln(24/16) */
+    {0x0000723FDF1E6A68ULL, 0x86B097607BCBFEE7ULL}   /* ln(25/16) */
+};
+
+static const fixed fixed_atan_eighths[9] = {
+    {0x0000000000000000ULL, 0x0000000000000000ULL},  /* atan(0/8) */
+    {0x00001FD5BA9AAC2FULL, 0x6DC65912F313E7D1ULL},  /* atan(1/8) */
+    {0x00003EB6EBF25901ULL, 0xBAC55B71E7BD7DE9ULL},  /* atan(2/8) */
+    {0x00005BD86507937BULL, 0xC239C55190916E7FULL},  /* atan(3/8) */
+    {0x000076B19C1586EDULL, 0x3DA2B7F222F65E1DULL},  /* atan(4/8) */
+    {0x00008F005D5EF7F5ULL, 0x9F9B5C835E1665C4ULL},  /* atan(5/8) */
+    {0x0000A4BC7D1934F7ULL, 0x092419A87F2A457EULL},  /* atan(6/8) */
+    {0x0000B8053E2BC231ULL, 0x9E73CB2DA55210A4ULL},  /* atan(7/8) */
+    {0x0000C90FDAA22168ULL, 0xC234C4C6628B80DCULL}   /* atan(8/8) */
+};
+
+/*
+    2/pi in 32 bit limbs, most significant first, for the reduction of radians.
+    That is enough bits to reduce the largest dec64 with REDUCE_LIMBS limbs of
+    fraction to spare.
+*/
+
+static const uint64 two_over_pi[25] = {
+    0xA2F9836EULL, 0x4E441529ULL, 0xFC2757D1ULL, 0xF534DDC0ULL,
+    0xDB629599ULL, 0x3C439041ULL, 0xFE5163ABULL, 0xDEBBC561ULL,
+    0xB7246E3AULL, 0x424DD2E0ULL, 0x06492EEAULL, 0x09D1921CULL,
+    0xFE1DEB1CULL, 0xB129A73EULL, 0xE88235F5ULL, 0x2EBB4484ULL,
+    0xE99C7026ULL, 0xB45F7E41ULL, 0x3991D639ULL, 0x835339F4ULL,
+    0x9C845F8BULL, 0xBDF9283BULL, 0x1FF897FFULL, 0xDE05980FULL,
+    0xEF2F118BULL
+};
+
+static int64 count_digits(int64 coefficient) {
+    int64 nr_digits = 1;
+    while (nr_digits < 19 && coefficient >= power[nr_digits]) {
+        nr_digits += 1;
+    }
+    return nr_digits;
+}
+
+static void multiply_64(uint64 a, uint64 b, uint64* high, uint64* low) {
+/*
+    Multiply two words, giving a product in two words.
+*/
+    uint64 a_high = a >> 32;
+    uint64 a_low = a & 0xFFFFFFFF;
+    uint64 b_high = b >> 32;
+    uint64 b_low = b & 0xFFFFFFFF;
+    uint64 low_low = a_low * b_low;
+    uint64 high_low = a_high * b_low;
+    uint64 low_high = a_low * b_high;
+    uint64 middle = (
+        (low_low >> 32)
+        + (high_low & 0xFFFFFFFF)
+        + (low_high & 0xFFFFFFFF)
+    );
+    *low = (middle << 32) | (low_low & 0xFFFFFFFF);
+    *high = (
+        a_high * b_high
+        + (high_low >> 32)
+        + (low_high >> 32)
+        + (middle >> 32)
     );
-    return result;
 }
 
-dec64 dec64_asin(dec64 slope) {
-    if (dec64_is_equal(slope, DEC64_ONE) == DEC64_TRUE) {
-        return D_HALF_PI;
-    }
-    if (dec64_is_equal(slope, DEC64_NEGATIVE_ONE) == DEC64_TRUE) {
-        return D_NHALF_PI;
-    }
-    if (
-        dec64_is_nan(slope) == DEC64_TRUE ||
-        dec64_is_less(DEC64_ONE, dec64_abs(slope)) == DEC64_TRUE
-    ) {
-        return DEC64_NULL;
+static uint64 divide_words(uint64 words[], int64 nr_words, uint64 divisor) {
+/*
+    Divide a number in words, least significant first, by a divisor less than
+    2**32, half a word at a time. It returns the remainder.
+*/
+    int64 at;
+    uint64 high;
+    uint64 low;
+    uint64 remainder = 0;
+
+    for (at = nr_words - 1; at >= 0; at -= 1) {
+        high = (remainder << 32) | (words[at] >> 32);
+        remainder = high % divisor;
+        low = (remainder << 32) | (words[at] & 0xFFFFFFFF);
+        remainder = low % divisor;
+        words[at] = ((high / divisor) << 32) | (low / divisor);
     }
-    dec64 bottom = DEC64_TWO;
-    dec64 factor = slope;
-    dec64 x2 = dec64_multiply(slope, slope);
-    dec64 result = factor;
-    while (1) {
-        factor = dec64_divide(
-            dec64_multiply(
-                dec64_multiply(dec64_add(DEC64_NEGATIVE_ONE, bottom), x2),
-                factor
-            ),
-            bottom
-        );
-        dec64 progress = dec64_add(
-            result,
-            dec64_divide(factor, dec64_add(DEC64_ONE, bottom))
-        );
-        if (result == progress) {
-            break;
-        }
-        result = progress;
-        bottom = dec64_add(bottom, DEC64_TWO);
+    return remainder;
+}
+
+static void add_word(uint64 words[], int64 at, uint64 value) {
+/*
+    Add a value into a number in words, least significant first, carrying as
+    far as needed.
+*/
+    while (value != 0) {
+        words[at] += value;
+        value = words[at] < value;
+        at += 1;
     }
+}
+
+static int fixed_is_negative(fixed a) {
+    return (int64)a.high < 0;
+}
+
+static int fixed_is_zero(fixed a) {
+    return (a.high | a.low) == 0;
+}
+
+static fixed fixed_negate(fixed a) {
+    fixed result;
+    result.low = ~a.low + 1;
+    result.high = ~a.high + (result.low == 0);
     return result;
 }
 
-dec64 dec64_atan(dec64 slope) {
-    return dec64_asin(
-        dec64_divide(
-            slope,
-            dec64_sqrt(dec64_add(DEC64_ONE, dec64_multiply(slope, slope)))
-        )
+static fixed fixed_abs(fixed a) {
+    return (
+        fixed_is_negative(a)
+        ? fixed_negate(a)
+        : a
     );
 }
 
-dec64 dec64_atan2(dec64 y, dec64 x) {
-    if (dec64_is_zero(x) == DEC64_TRUE) {
-        if (dec64_is_zero(y) == DEC64_TRUE) {
-            return DEC64_NULL;
-        } else if (y < 0) {
-            return D_NHALF_PI;
-        } else {
-            return D_HALF_PI;
-        }
-    } else {
-        dec64 atan = dec64_atan(dec64_divide(y, x));
-        if (x < 0) {
-            if (y < 0) {
-                return dec64_subtract(atan, D_HALF_PI);
-            } else {
-                return dec64_add(atan, D_HALF_PI);
-            }
-        } else {
-            return atan;
-        }
-    }
+static fixed fixed_add(fixed a, fixed b) {
+    fixed result;
+    result.low = a.low + b.low;
+    result.high = a.high + b.high + (result.low < a.low);
+    return result;
 }
 
-dec64 dec64_cos(dec64 radians) {
-    return dec64_sin(dec64_add(radians, D_HALF_PI));
+static fixed fixed_subtract(fixed a, fixed b) {
+    return fixed_add(a, fixed_negate(b));
 }
 
-dec64 dec64_exp(dec64 exponent) {
-        dec64 result = dec64_add(DEC64_ONE, exponent);
-        dec64 divisor = DEC64_TWO;
-        dec64 term = exponent;
-        while (1) {
-            term = dec64_divide(
-                dec64_multiply(term, exponent),
-                divisor
-            );
-            dec64 progress = dec64_add(result, term);
-            if (result == progress) {
-                break;
-            }
-            result = progress;
-            divisor = dec64_add(DEC64_ONE, divisor);
-        }
-        return result;
+static fixed fixed_from_int(int64 integer) {
+    fixed result;
+    result.high = (uint64)integer << 48;
+    result.low = 0;
+    return result;
 }
 
-dec64 dec64_raise(dec64 coefficient, dec64 exponent) {
-    if (dec64_is_zero(exponent) == DEC64_TRUE) {
-        return DEC64_ONE;
-    }
+static int64 fixed_floor(fixed a) {
+    return (int64)a.high >> 48;
+}
 
-// Adjust for a negative exponent.
+static fixed fixed_multiply(fixed a, fixed b) {
+/*
+    Multiply the magnitudes into four words, and keep the middle, rounded.
+*/
+    int negative = fixed_is_negative(a) != fixed_is_negative(b);
+    uint64 high;
+    uint64 low;
+    fixed result;
+    uint64 word_1;
+    uint64 word_2;
+    uint64 word_3;
 
-    if (exponent < 0) {
-        coefficient = dec64_divide(DEC64_ONE, coefficient);
-        exponent = dec64_neg(exponent);
-    }
-    if (dec64_is_nan(coefficient) == DEC64_TRUE) {
-        return DEC64_NULL;
-    }
-    if (dec64_is_zero(coefficient) == DEC64_TRUE) {
-        return 0;
+    a = fixed_abs(a);
+    b = fixed_abs(b);
+    multiply_64(a.low, b.low, &word_1, &low);
+    multiply_64(a.high, b.low, &high, &low);
+    word_1 += low;
+    word_2 = high + (word_1 < low);
+    multiply_64(a.low, b.high, &high, &low);
+    word_1 += low;
+    word_2 += word_1 < low;
+    word_2 += high;
+    word_3 = word_2 < high;
+    multiply_64(a.high, b.high, &high, &low);
+    word_2 += low;
+    word_3 += high + (word_2 < low);
+    result.low = (word_1 >> 48) | (word_2 << 16);
+    result.high = (word_2 >> 48) | (word_3 << 16);
+    if ((word_1 >> 47) & 1) {
+        result.low += 1;
+        result.high += result.low == 0;
     }
+    return (
+        negative
+        ? fixed_negate(result)
+        : result
+    );
+}
 
-// If the exponent is an integer, then use the squaring method.
+static fixed fixed_multiply_int(fixed a, int64 integer) {
+    uint64 high;
+    int negative = fixed_is_negative(a) != (integer < 0);
+    fixed result;
 
-    if (exponent > 0 && dec64_exponent(exponent) == 0) {
-        dec64 aux = DEC64_ONE;
-        int64 n = dec64_coefficient(exponent);
-        if (n <= 1) {
-            return coefficient;
-        }
-        while (n > 1) {
-            if ((n & 1) != 0) {
-                aux = dec64_multiply(aux, coefficient);
-            }
-            coefficient = dec64_multiply(coefficient, coefficient);
-            n /= 2;
-        }
-        return (n == 1)
-            ? dec64_multiply(aux, coefficient)
-            : aux;
+    a = fixed_abs(a);
+    if (integer < 0) {
+        integer = -integer;
     }
+    multiply_64(a.low, (uint64)integer, &high, &result.low);
+    result.high = a.high * (uint64)integer + high;
+    return (
+        negative
+        ? fixed_negate(result)
+        : result
+    );
+}
 
-// Otherwise do it the hard way.
+static fixed polynomial(const fixed coefficients[], int64 degree, fixed x) {
+/*
+    Evaluate a polynomial by Horner's method.
+*/
+    fixed sum = coefficients[degree];
 
-    return dec64_exp(dec64_multiply(
-        dec64_log(coefficient),
-        exponent
-    ));
+    for (degree -= 1; degree >= 0; degree -= 1) {
+        COUNT(DEC64_MATH_SERIES, 1);
+        sum = fixed_add(coefficients[degree], fixed_multiply(sum, x));
+    }
+    return sum;
 }
 
-dec64 dec64_factorial(dec64 x) {
-    dec64 n = dec64_normal(x);
-    int64 c = dec64_coefficient(n);
-    if (c >= 0 && c < FAC && dec64_exponent(n) == 0) {
-        return factorials[c];
+static fixed fixed_divide_int(fixed a, int64 divisor) {
+/*
+    Divide by a positive integer less than 2**32, rounded.
+*/
+    int negative = fixed_is_negative(a);
+    uint64 words[2];
+    fixed result;
+
+    a = fixed_abs(a);
+    words[0] = a.low;
+    words[1] = a.high;
+    if (divide_words(words, 2, (uint64)divisor) * 2 >= (uint64)divisor) {
+        words[0] += 1;
+        words[1] += words[0] == 0;
     }
-    return DEC64_NULL;
+    result.high = words[1];
+    result.low = words[0];
+    return (
+        negative
+        ? fixed_negate(result)
+        : result
+    );
 }
 
-dec64 dec64_log(dec64 x) {
-    if (x <= 0 || dec64_is_nan(x) == DEC64_TRUE) {
-        return DEC64_NULL;
-    }
-    if (dec64_is_equal(x, DEC64_ONE) == DEC64_TRUE) {
-        return DEC64_ZERO;
-    }
-    if (dec64_is_equal(x, D_HALF) == DEC64_TRUE) {
-        return dec64_new(-6931471805599453, -16);
+static fixed fixed_divide_power(fixed a, int64 exponent) {
+/*
+    Divide by 10**exponent, where exponent >= 0.
+*/
+    int64 step;
+
+    if (exponent > 36) {
+        return fixed_from_int(0);
     }
-    if (x == D_E) {
-        return DEC64_ONE;
+    while (exponent > 0) {
+        step = (
+            exponent > 9
+            ? 9
+            : exponent
+        );
+        a = fixed_divide_int(a, power[step]);
+        exponent -= step;
     }
-    dec64 y = dec64_divide(dec64_add(DEC64_NEGATIVE_ONE, x), x);
-    dec64 factor = y;
-    dec64 result = factor;
-    dec64 divisor = DEC64_TWO;
+    return a;
+}
 
-    while (1) {
-        factor = dec64_multiply(factor, y);
-        dec64 progress = dec64_add(
-            result,
-            dec64_divide(factor, divisor)
-        );
-        if (result == progress || progress == DEC64_NULL) {
-            break;
-        }
-        result = progress;
-        divisor = dec64_add(DEC64_ONE, divisor);
+static double fixed_to_double(fixed a) {
+    if (fixed_is_negative(a)) {
+        return -fixed_to_double(fixed_negate(a));
     }
-    return result;
+    return (
+        (double)a.high / 281474976710656.0
+        + (double)a.low / 5192296858534827628530496329220096.0
+    );
+}
+
+static fixed fixed_from_double(double number) {
+    int negative = number < 0;
+    fixed result;
+    double scaled = (
+        negative
+        ? -number
+        : number
+    ) * 281474976710656.0;
+
+    result.high = (uint64)scaled;
+    result.low = (uint64)((scaled - (double)result.high) * 18446744073709551616.0);
+    return (
+        negative
+        ? fixed_negate(result)
+        : result
+    );
 }
 
+static fixed fixed_divide(fixed a, fixed b) {
 /*
-    The seed variables contain the random number generator's state.
-    They can be set by dec64_seed.
+    Divide, starting from a double estimate, and then twice adding the
+    quotient of the remainder a - quotient * b. Each correction takes the
+    error down by the 53 bits of a double. The magnitude of the quotient must
+    be less than 32768.
 */
+    double divisor = fixed_to_double(b);
+    int pass;
+    fixed quotient = fixed_from_double(fixed_to_double(a) / divisor);
 
-static uint64 seed_0 = D_E;
-static uint64 seed_1 = D_2PI;
+    for (pass = 0; pass < 2; pass += 1) {
+        COUNT(DEC64_MATH_NEWTON, 1);
+        quotient = fixed_add(
+            quotient,
+            fixed_from_double(
+                fixed_to_double(
+                    fixed_subtract(a, fixed_multiply(quotient, b))
+                ) / divisor
+            )
+        );
+    }
+    return quotient;
+}
 
-dec64 dec64_random() {
+static fixed fixed_sqrt(fixed a) {
 /*
-    Return a number between 0 and 1 containing 16 randomy digits.
-    It uses xorshift128+.
+    The square root of a positive fixed, by Newton's method from a double
+    estimate.
 */
-    while (1) {
-        uint64 s1 = seed_0;
-        uint64 s0 = seed_1;
-        s1 ^= s1 << 23;
-        s1 ^= s0 ^ (s0 >> 5) ^ (s1 >> 18);
-        seed_0 = s0;
-        seed_1 = s1;
-        uint64 mantissa = (s1 + s0) >> 10;
+    int pass;
+    fixed root = fixed_from_double(sqrt(fixed_to_double(a)));
+
+    for (pass = 0; pass < 2; pass += 1) {
+        COUNT(DEC64_MATH_NEWTON, 1);
+        root = fixed_divide_int(fixed_add(root, fixed_divide(a, root)), 2);
+    }
+    return root;
+}
+
+static fixed fixed_from_decimal(int64 coefficient, int64 exponent) {
 /*
-    mantissa contains an integer between 0 and 18014398509481983.
-    If it is less than or equal to 9999999999999999 then we are done.
+    Convert coefficient * 10**exponent, whose magnitude is less than 32768. The
+    coefficient is shifted into three words and then divided by the power of
+    ten.
 */
-        if (mantissa <= 9999999999999999LL) {
-            return dec64_new(mantissa, -16);
+    uint64 magnitude = (
+        coefficient < 0
+        ? -(uint64)coefficient
+        : (uint64)coefficient
+    );
+    fixed result;
+    uint64 words[3];
+
+    if (exponent >= 0) {
+        result = fixed_from_int((int64)magnitude * power[exponent]);
+    } else {
+        words[0] = 0;
+        words[1] = magnitude << 48;
+        words[2] = magnitude >> 16;
+        exponent = -exponent;
+        while (exponent > 0 && (words[0] | words[1] | words[2]) != 0) {
+            int64 step = (
+                exponent > 9
+                ? 9
+                : exponent
+            );
+            divide_words(words, 3, (uint64)power[step]);
+            exponent -= step;
         }
+        result.high = words[1];
+        result.low = words[0];
     }
+    return (
+        coefficient < 0
+        ? fixed_negate(result)
+        : result
+    );
 }
 
-dec64 dec64_root(dec64 index, dec64 radicand) {
-    dec64 result;
-    index = dec64_normal(index);
-    if (
-        dec64_is_nan(radicand) == DEC64_TRUE
-        || dec64_is_zero(index) == DEC64_TRUE
-        || index < 0
-        || dec64_exponent(index) != 0
-        || (
-            radicand < 0
-            && (dec64_coefficient(index) & 1) == 0
-        )
-    ) {
-        return DEC64_NULL;
+static fixed fixed_from_dec64(dec64 number) {
+    return fixed_from_decimal(
+        dec64_coefficient(number),
+        dec64_exponent(number)
+    );
+}
+
+static dec64 pack_digits(int negative, uint64 digits, int64 exponent) {
+/*
+    Round an 18 digit integer, digits * 10**exponent, to 17 digits if they fit
+    in a coefficient, or else 16. Trailing zeros after the decimal point are
+    removed.
+*/
+    int64 coefficient;
+
+    if (digits / 10 <= 36028797018963967ULL) {
+        coefficient = (int64)(digits / 10) + (digits % 10 >= 5);
+        exponent += 1;
+    } else {
+        coefficient = (int64)(digits / 100) + ((digits / 10) % 10 >= 5);
+        exponent += 2;
     }
-    if (dec64_is_zero(radicand) == DEC64_TRUE) {
+    while (exponent < 0 && coefficient % 10 == 0) {
+        coefficient /= 10;
+        exponent += 1;
+    }
+    return dec64_new(
+        negative
+        ? -coefficient
+        : coefficient,
+        exponent
+    );
+}
+
+static dec64 fixed_pack(fixed a, int64 exponent) {
+/*
+    Round a * 10**exponent to a dec64. First scale a so that 0.1 <= a < 1,
+    then take 18 digits and pack them.
+*/
+    uint64 digits;
+    uint64 high;
+    uint64 low;
+    int negative = fixed_is_negative(a);
+    uint64 word_1;
+
+    if (fixed_is_zero(a)) {
         return DEC64_ZERO;
     }
-    if (index == DEC64_ONE) {
-        return radicand;
+    a = fixed_abs(a);
+    while (a.high >= fixed_one.high) {
+        a = fixed_divide_int(a, 10);
+        exponent += 1;
     }
-    if (index == DEC64_TWO) {
-        return dec64_sqrt(radicand);
+    while (a.high < (fixed_one.high >> 30)) {
+        a = fixed_multiply_int(a, 1000000000);
+        exponent -= 9;
     }
-    dec64 index_minus_one = dec64_add(DEC64_NEGATIVE_ONE, index);
-    result = DEC64_ONE;
-    dec64 prosult = DEC64_NULL;
     while (1) {
-        dec64 progress = dec64_divide(
-            dec64_add(
-                dec64_multiply(result, index_minus_one),
-                dec64_divide(
-                    radicand,
-                    dec64_raise(result, index_minus_one)
-                )
-            ),
-            index
-        );
-        if (progress == result) {
-            return result;
-        }
-        if (progress == prosult) {
-            return dec64_divide(dec64_add(progress, result), DEC64_TWO);
+        fixed tenfold = fixed_multiply_int(a, 10);
+        if (tenfold.high >= fixed_one.high) {
+            break;
         }
-        prosult = result;
-        result = progress;
+        a = tenfold;
+        exponent -= 1;
     }
+    multiply_64(a.low, (uint64)power[18], &word_1, &low);
+    multiply_64(a.high, (uint64)power[18], &high, &low);
+    word_1 += low;
+    high += word_1 < low;
+    digits = (high << 16) | (word_1 >> 48);
+    return pack_digits(negative, digits, exponent - 18);
 }
 
-void dec64_seed(uint64 part_0, uint64 part_1) {
+/* functions in service to exp */
+
+static void exp_reduce(fixed x, fixed* r, int64* j, int64* k) {
 /*
-    Seed the dec64_random function. It takes any 128 bits as the seed value.
-    The seed must contain at least one 1 bit.
+    Reduce the exponent x by a multiple k of ln(10) and a multiple j of 1/8,
+    so that
+
+        e**x = 10**k * e**(j/8) * e**r
+
+    where 0 <= r < 1/8. e**r is computed with a polynomial of fixed degree, and
+    the power of ten goes into the exponent of the result. The Taylor series
+    for e**r to the r**14 term is good to 26 digits.
 */
-    seed_0 = part_0;
-    seed_1 = part_1;
-    if ((seed_0 | seed_1) == 0) {
-        seed_1 = 1;
+    *k = fixed_floor(fixed_multiply(x, fixed_log10_e));
+    *r = fixed_subtract(x, fixed_multiply_int(fixed_ln10, *k));
+    if (fixed_is_negative(*r)) {
+        *k -= 1;
+        *r = fixed_add(*r, fixed_ln10);
     }
+    *j = fixed_floor(fixed_multiply_int(*r, 8));
+    *r = fixed_subtract(*r, fixed_divide_int(fixed_from_int(*j), 8));
 }
 
-dec64 dec64_sin(dec64 radians) {
-    while (dec64_is_less(D_PI, radians) == DEC64_TRUE) {
-        radians = dec64_subtract(radians, D_PI);
-        radians = dec64_subtract(radians, D_PI);
+static dec64 exp_finish(fixed sum, int64 j, int64 k) {
+    return fixed_pack(fixed_multiply(sum, fixed_exp_eighths[j]), k);
+}
+
+static int exp_special(dec64 exponent, dec64* result) {
+/*
+    Deliver the result for an exponent that is nan or out of range.
+*/
+    if (dec64_is_nan(exponent) == DEC64_TRUE) {
+        *result = DEC64_NULL;
+        return 1;
     }
-    while (dec64_is_less(radians, D_NPI) == DEC64_TRUE) {
-        radians = dec64_add(radians, D_PI);
-        radians = dec64_add(radians, D_PI);
+    if (dec64_is_less(D_EXP_MAX, exponent) == DEC64_TRUE) {
+        *result = DEC64_NULL;
+        return 1;
     }
-    int neg = 0;
-    if (radians < 0) {
-        radians = dec64_neg(radians);
-        neg = -1;
+    if (dec64_is_less(exponent, dec64_neg(D_EXP_MAX)) == DEC64_TRUE) {
+        *result = DEC64_ZERO;
+        return 1;
     }
-    if (dec64_is_less(D_HALF_PI, radians) == DEC64_TRUE) {
-        radians = dec64_subtract(D_PI, radians);
+    return 0;
+}
+
+static dec64 exp_fixed(fixed x) {
+    int64 j;
+    int64 k;
+    fixed r;
+
+    exp_reduce(x, &r, &j, &k);
+    return exp_finish(polynomial(fixed_exp_coefficients, 14, r), j, k);
+}
+
+/* functions in service to the logarithms */
+
+static fixed log_series(fixed z) {
+/*
+    Compute ln(1 + z) / z, where |z| < 1/24, with the Taylor series to the
+    z**17 term, which is good to 27 digits.
+*/
+    return polynomial(fixed_log_coefficients, 17, z);
+}
+
+static int log_reduce(dec64 x, int64* decimal, fixed* base, fixed* z) {
+/*
+    Take x = m * 10**decimal, where 0.316 < m < 3.163, and then take
+    m = 2**binary * (1 + j/16) * (1 + z), where |z| < 1/24, so that
+
+        ln(m) = binary * ln(2) + ln(1 + j/16) + ln(1 + z)
+
+    The first two come from tables and are delivered as the base, and then
+    ln(m) = base + z * log_series(z). It returns 1 if x is near 1, in which
+    case the caller should use log_near_one instead.
+*/
+    int64 binary = 0;
+    int64 coefficient = dec64_coefficient(x);
+    int64 exponent = dec64_exponent(x);
+    int64 j;
+    fixed m;
+    int64 nr_digits = count_digits(coefficient);
+
+    if (coefficient * power[17 - nr_digits] > 31622776601683793LL) {
+        nr_digits += 1;
     }
-    dec64 result;
-    if (radians == D_HALF_PI) {
-        result = DEC64_ONE;
-    } else {
-        dec64 x2 = dec64_multiply(radians, radians);
-        dec64 order = DEC64_ONE;
-        dec64 term = radians;
-        result = term;
-        while (1) {
-            term = dec64_multiply(term, x2);
-            order = dec64_add(DEC64_ONE, order);
-            term = dec64_divide(term, order);
-            order = dec64_add(DEC64_ONE, order);
-            term = dec64_divide(term, order);
-            dec64 progress = dec64_subtract(result, term);
-
-            term = dec64_multiply(term, x2);
-            order = dec64_add(DEC64_ONE, order);
-            term = dec64_divide(term, order);
-            order = dec64_add(DEC64_ONE, order);
-            term = dec64_divide(term, order);
-            progress = dec64_add(progress, term);
-
-            if (progress == result) {
-                break;
-            }
-            result = progress;
-        }
+    *decimal = exponent + nr_digits - 1;
+    m = fixed_from_decimal(coefficient, 1 - nr_digits);
+    if (m.high < 0x0000600000000000ULL) {
+        m = fixed_multiply_int(m, 4);
+        binary = -2;
+    } else if (m.high < 0x0000C00000000000ULL) {
+        m = fixed_multiply_int(m, 2);
+        binary = -1;
+    } else if (m.high >= 0x0001800000000000ULL) {
+        m = fixed_divide_int(m, 2);
+        binary = 1;
     }
-    if (neg) {
-        result = dec64_neg(result);
+    j = fixed_floor(fixed_add(fixed_multiply_int(m, 16), fixed_half)) - 16;
+    if (*decimal == 0 && binary == 0 && j == 0) {
+        return 1;
     }
-    return result;
+    *z = fixed_subtract(
+        fixed_multiply(m, fixed_log_reciprocal[j + 4]),
+        fixed_one
+    );
+    *base = fixed_add(
+        fixed_multiply_int(fixed_ln2, binary),
+        fixed_log_sixteenths[j + 4]
+    );
+    return 0;
 }
 
-dec64 dec64_sqrt(dec64 radicand) {
-    if (dec64_is_nan(radicand) == DEC64_FALSE && radicand >= 0) {
-        if (dec64_coefficient(radicand) == 0) {
-            return DEC64_ZERO;
-        }
-        dec64 result = radicand;
-        if (dec64_is_less(DEC64_ONE, result)) {
-            result = dec64_divide(result, DEC64_TWO);
-        }
-        while (1) {
-            dec64 progress = dec64_divide(
-                dec64_add(
-                    result,
-                    dec64_divide(radicand, result)
-                ),
-                DEC64_TWO
-            );
-            if (progress == result) {
-                return result;
-            }
-            result = progress;
-        }
-        return result;
-    } else {
-        return DEC64_NULL;
-    }
+static fixed log_mantissa(fixed base, fixed z) {
+    return fixed_add(base, fixed_multiply(z, log_series(z)));
 }
 
-dec64 dec64_tan(dec64 radians) {
-    return dec64_divide(
-        dec64_sin(radians),
-        dec64_cos(radians)
+static int log_special(dec64 x, dec64* result) {
+/*
+    The logarithms are nan for nan, zero, and the negatives.
+*/
+    if (
+        x <= 0
+        || dec64_is_nan(x) == DEC64_TRUE
+        || dec64_is_zero(x) == DEC64_TRUE
+    ) {
+        *result = DEC64_NULL;
+        return 1;
+    }
+    return 0;
+}
+
+static dec64 log_near_one(dec64 x, fixed factor) {
+/*
+    When x is near 1, its logarithm is near 0, so keep all of the digits of
+    z = x - 1, which is exact, and return factor * ln(1 + z).
+*/
+    int64 coefficient;
+    int64 nr_digits;
+    fixed product;
+    dec64 z = dec64_subtract(x, DEC64_ONE);
+
+    if (dec64_is_zero(z) == DEC64_TRUE) {
+        return DEC64_ZERO;
+    }
+    coefficient = dec64_coefficient(z);
+    nr_digits = count_digits(
+        coefficient < 0
+        ? -coefficient
+        : coefficient
+    );
+    product = fixed_multiply(
+        fixed_multiply(
+            fixed_from_decimal(coefficient, -nr_digits),
+            log_series(fixed_from_dec64(z))
+        ),
+        factor
+    );
+    return fixed_pack(product, dec64_exponent(z) + nr_digits);
+}
+
+/* functions in service to raise */
+
+static fixed log_fixed(dec64 x) {
+/*
+    ln(x) for a positive x, not rounded.
+*/
+    fixed base;
+    int64 decimal;
+    fixed z;
+
+    if (log_reduce(x, &decimal, &base, &z)) {
+        z = fixed_from_dec64(dec64_subtract(x, DEC64_ONE));
+        return fixed_multiply(z, log_series(z));
+    }
+    return fixed_add(
+        fixed_multiply_int(fixed_ln10, decimal),
+        log_mantissa(base, z)
+    );
+}
+
+static fixed fixed_log(fixed a) {
+/*
+    ln(a) for a positive fixed. a is rounded to a dec64 d, and then
+
+        ln(a) = ln(d) + ln(a / d)
+
+    where a / d is so close to 1 that ln(a / d) is (a - d) / d.
+*/
+    dec64 rounded = fixed_pack(a, 0);
+    fixed d = fixed_from_dec64(rounded);
+
+    return fixed_add(
+        log_fixed(rounded),
+        fixed_divide(fixed_subtract(a, d), d)
+    );
+}
+
+static const uint64 ten_36[2] = {0xB34B9F1000000000ULL, 0x00C097CE7BC90715ULL};
+
+static int64 wide_multiply(uint64 a[2], uint64 b[2], uint64 product[2], int* inexact) {
+/*
+    A wide is a 128 bit integer in two words, least significant first, that
+    holds 36 digits: 10**35 <= wide < 10**36. Multiply two wides, keeping the
+    36 leading digits of the product. It returns the number of digits that
+    were dropped, and sets *inexact if any of them were not zero.
+*/
+    uint64 high;
+    uint64 low;
+    int64 nr_dropped = 35;
+    int64 step;
+    uint64 words[4] = {0, 0, 0, 0};
+
+    multiply_64(a[0], b[0], &words[1], &words[0]);
+    multiply_64(a[1], b[1], &words[3], &words[2]);
+    multiply_64(a[0], b[1], &high, &low);
+    add_word(words, 1, low);
+    add_word(words, 2, high);
+    multiply_64(a[1], b[0], &high, &low);
+    add_word(words, 1, low);
+    add_word(words, 2, high);
+    for (step = 35; step > 0; step -= 9) {
+        if (divide_words(words, 4, (uint64)power[
+            step > 9
+            ? 9
+            : step
+        ]) != 0) {
+            *inexact = 1;
+        }
+    }
+    if (
+        words[1] > ten_36[1]
+        || (words[1] == ten_36[1] && words[0] >= ten_36[0])
+    ) {
+        if (divide_words(words, 2, 10) != 0) {
+            *inexact = 1;
+        }
+        nr_dropped = 36;
+    }
+    product[0] = words[0];
+    product[1] = words[1];
+    return nr_dropped;
+}
+
+static int64 wide_from_integer(uint64 magnitude, uint64 wide[2]) {
+/*
+    Scale a nonzero integer up into a wide. It returns the exponent of the
+    wide, so that magnitude = wide * 10**exponent.
+*/
+    uint64 high;
+    uint64 low;
+    int64 scale = 36 - count_digits((int64)magnitude);
+
+    multiply_64(
+        magnitude,
+        (uint64)power[
+            scale > 18
+            ? 18
+            : scale
+        ],
+        &high,
+        &low
+    );
+    if (scale > 18) {
+        multiply_64(low, (uint64)power[scale - 18], &wide[1], &wide[0]);
+        wide[1] += high * (uint64)power[scale - 18];
+    } else {
+        wide[0] = low;
+        wide[1] = high;
+    }
+    return -scale;
+}
+
+static fixed wide_mantissa(uint64 wide[2]) {
+/*
+    Convert a wide to a fixed between 1 and 10, wide / 10**35.
+*/
+    fixed mantissa;
+    int64 scale;
+    uint64 words[4];
+
+    words[0] = 0;
+    words[1] = wide[0] << 48;
+    words[2] = (wide[0] >> 16) | (wide[1] << 48);
+    words[3] = wide[1] >> 16;
+    for (scale = 35; scale > 0; scale -= 9) {
+        divide_words(words, 4, (uint64)power[
+            scale > 9
+            ? 9
+            : scale
+        ]);
+    }
+    mantissa.high = words[1];
+    mantissa.low = words[0];
+    return mantissa;
+}
+
+static dec64 raise_integer(int64 coefficient, int64 exponent, int64 n) {
+/*
+    Raise coefficient * 10**exponent to an integer power n, where neither is
+    0, by squaring and multiplying 36 digit wides. Digits are only dropped
+    when they do not fit, so a power that has 36 digits or fewer, like
+    1.05**12, is exact until the final rounding.
+*/
+    int64 base_exponent;
+    int inexact = 0;
+    uint64 base[2];
+    uint64 magnitude;
+    int64 magnitude_exponent;
+    int64 nr_digits;
+    int negative = coefficient < 0 && (n & 1) != 0;
+    uint64 power_of_n;
+    uint64 result[2];
+    int64 result_exponent = 0;
+    int started = 0;
+
+    magnitude = (
+        coefficient < 0
+        ? -(uint64)coefficient
+        : (uint64)coefficient
+    );
+    nr_digits = count_digits((int64)magnitude);
+
+/*
+    The magnitude is between 10**magnitude_exponent and 10 times that, so the
+    power is between 10**(n * magnitude_exponent) and 10**(n *
+    (magnitude_exponent + 1)). If that is out of range, there is no need to
+    compute it.
+*/
+
+    magnitude_exponent = exponent + nr_digits - 1;
+    if (n > 0) {
+        if (n * magnitude_exponent >= 144) {
+            return DEC64_NULL;
+        }
+        if (n * (magnitude_exponent + 1) <= -128) {
+            return DEC64_ZERO;
+        }
+    } else {
+        if (n * (magnitude_exponent + 1) >= 144) {
+            return DEC64_NULL;
+        }
+        if (n * magnitude_exponent <= -128) {
+            return DEC64_ZERO;
+        }
+    }
+
+    base_exponent = exponent + wide_from_integer(magnitude, base);
+    power_of_n = (uint64)(
+        n < 0
+        ? -n
+        : n
+    );
+    while (1) {
+        COUNT(DEC64_MATH_SQUARE, 1);
+        if ((power_of_n & 1) != 0) {
+            if (started) {
+                result_exponent += base_exponent + wide_multiply(
+                    result,
+                    base,
+                    result,
+                    &inexact
+                );
+            } else {
+                result[0] = base[0];
+                result[1] = base[1];
+                result_exponent = base_exponent;
+                started = 1;
+            }
+        }
+        power_of_n >>= 1;
+        if (power_of_n == 0) {
+            break;
+        }
+        base_exponent = 2 * base_exponent + wide_multiply(
+            base,
+            base,
+            base,
+            &inexact
+        );
+    }
+
+/*
+    For a negative n, take the reciprocal in fixed point.
+*/
+
+    if (n < 0) {
+        fixed mantissa = fixed_divide(fixed_one, wide_mantissa(result));
+        return fixed_pack(
+            negative
+            ? fixed_negate(mantissa)
+            : mantissa,
+            -(result_exponent + 35)
+        );
+    }
+
+/*
+    Take the leading 18 digits. The inexact flag is not needed here, because
+    the digits that were dropped were not enough to change a rounding that
+    goes half away from zero, and a result that was exact stays exact.
+*/
+
+    divide_words(result, 2, (uint64)power[9]);
+    divide_words(result, 2, (uint64)power[9]);
+    return pack_digits(negative, result[0], result_exponent + 18);
+}
+
+static int is_integer(dec64 number, int64* integer, int* odd) {
+/*
+    If the number is an integer, return 1 and tell if it is odd. If its
+    magnitude is no more than 2**16, also deliver it as an int64, or else 0.
+*/
+    int64 coefficient = dec64_coefficient(number);
+    int64 exponent = dec64_exponent(number);
+
+    if (exponent < 0) {
+        if (exponent < -17 || coefficient % power[-exponent] != 0) {
+            return 0;
+        }
+        coefficient /= power[-exponent];
+        exponent = 0;
+    }
+    *odd = exponent == 0 && (coefficient & 1) != 0;
+    *integer = 0;
+    if (coefficient >= -65536 && coefficient <= 65536 && exponent <= 5) {
+        coefficient *= power[exponent];
+        if (coefficient >= -65536 && coefficient <= 65536) {
+            *integer = coefficient;
+        }
+    }
+    return 1;
+}
+
+/* functions in service to the trigonometry */
+
+static int64 reduce_radians(dec64 radians, fixed* reduced, int64* scale) {
+/*
+    Find the quadrant q and the remainder r such that
+
+        radians = q * pi/2 + r      where |r| <= pi/4
+
+    The product of the radians and 2/pi is formed in 32 bit limbs (Payne-Hanek),
+    keeping only the two low bits of its integer part and REDUCE_LIMBS limbs of
+    fraction, so the work is bounded no matter how large the radians. The
+    fraction is then scaled by powers of ten so that the remainder keeps its
+    precision when the radians are very close to a multiple of pi/2. It is
+    delivered as r = reduced * 10**-scale, where |reduced| is at least 0.157
+    unless the remainder is zero.
+
+    A radians that is the nearest dec64 to a multiple of pi/2 is taken to be
+    that multiple, so sin(pi) is 0 and tan(pi/2) is nan.
+
+    The caller must take care of nan and of radians smaller than 1e-9.
+*/
+    uint64 accumulator[REDUCE_LIMBS + 2];
+    int64 at;
+    uint64 carry;
+    int64 coefficient = dec64_coefficient(radians);
+    int64 exponent = dec64_exponent(radians);
+    fixed fraction;
+    int64 i;
+    int64 j;
+    uint64 magnitude;
+    uint64 multiplicand[15];
+    int64 nr_digits;
+    int64 nr_limbs = 2;
+    uint64 product;
+    int64 quadrant;
+    int64 spacing;
+    int64 step;
+    uint64 top;
+
+    magnitude = (
+        coefficient < 0
+        ? -(uint64)coefficient
+        : (uint64)coefficient
+    );
+    nr_digits = count_digits((int64)magnitude);
+
+/*
+    The spacing of dec64 numbers near the radians is 10**spacing.
+*/
+
+    spacing = exponent + nr_digits - 1 - 16;
+    if ((int64)magnitude * power[17 - nr_digits] > 36028797018963967LL) {
+        spacing += 1;
+    }
+
+/*
+    If the exponent is positive, the radians are a big integer, and only the
+    limbs of 2/pi that can reach the low bits of the integer part are used.
+    Otherwise, the coefficient is multiplied by 2/pi and the product is divided
+    by a power of ten.
+*/
+
+    multiplicand[0] = magnitude & 0xFFFFFFFF;
+    multiplicand[1] = magnitude >> 32;
+    while (exponent > 0) {
+        step = (
+            exponent > 9
+            ? 9
+            : exponent
+        );
+        carry = 0;
+        for (at = 0; at < nr_limbs; at += 1) {
+            product = multiplicand[at] * (uint64)power[step] + carry;
+            multiplicand[at] = product & 0xFFFFFFFF;
+            carry = product >> 32;
+        }
+        if (carry != 0) {
+            multiplicand[nr_limbs] = carry;
+            nr_limbs += 1;
+        }
+        exponent -= step;
+    }
+    for (at = 0; at < REDUCE_LIMBS + 2; at += 1) {
+        accumulator[at] = 0;
+    }
+    for (j = 0; j < nr_limbs; j += 1) {
+        i = (
+            (exponent == 0 && j > 1)
+            ? j - 1
+            : 0
+        );
+        for (; i < 25; i += 1) {
+            at = j - i - 1 + REDUCE_LIMBS;
+            if (at < -1) {
+                break;
+            }
+            product = multiplicand[j] * two_over_pi[i];
+            if (at >= 0) {
+                accumulator[at] += product & 0xFFFFFFFF;
+            }
+            accumulator[at + 1] += product >> 32;
+        }
+    }
+    for (at = 0; at <= REDUCE_LIMBS; at += 1) {
+        accumulator[at + 1] += accumulator[at] >> 32;
+        accumulator[at] &= 0xFFFFFFFF;
+    }
+    while (exponent < 0) {
+        step = (
+            exponent < -9
+            ? 9
+            : -exponent
+        );
+        carry = 0;
+        for (at = REDUCE_LIMBS + 1; at >= 0; at -= 1) {
+            product = (carry << 32) | accumulator[at];
+            accumulator[at] = product / (uint64)power[step];
+            carry = product % (uint64)power[step];
+        }
+        exponent += step;
+    }
+    quadrant = (int64)(accumulator[REDUCE_LIMBS] & 3);
+
+/*
+    If the fraction is more than a half, go to the next quadrant and take the
+    remainder as negative.
+*/
+
+    if ((accumulator[REDUCE_LIMBS - 1] & 0x80000000) != 0) {
+        carry = 1;
+        for (at = 0; at < REDUCE_LIMBS; at += 1) {
+            product = (~accumulator[at] & 0xFFFFFFFF) + carry;
+            accumulator[at] = product & 0xFFFFFFFF;
+            carry = product >> 32;
+        }
+        quadrant = -(quadrant + 1);
+    }
+    *scale = 0;
+    while (*scale < 50) {
+        top = accumulator[REDUCE_LIMBS - 1];
+        if (top >= 0x19999999) {
+            break;
+        }
+        step = (
+            (top == 0 && *scale <= 41)
+            ? 9
+            : 1
+        );
+        carry = 0;
+        for (at = 0; at < REDUCE_LIMBS; at += 1) {
+            product = accumulator[at] * (uint64)power[step] + carry;
+            accumulator[at] = product & 0xFFFFFFFF;
+            carry = product >> 32;
+        }
+        *scale += step;
+    }
+    fraction.high = (
+        (accumulator[REDUCE_LIMBS - 1] << 16)
+        | (accumulator[REDUCE_LIMBS - 2] >> 16)
+    );
+    fraction.low = (
+        (accumulator[REDUCE_LIMBS - 2] << 48)
+        | (accumulator[REDUCE_LIMBS - 3] << 16)
+        | (accumulator[REDUCE_LIMBS - 4] >> 16)
+    );
+    *reduced = fixed_multiply(fraction, fixed_half_pi);
+
+/*
+    If the remainder is no more than half of the spacing, then the radians are
+    the dec64 nearest to q * pi/2.
+*/
+
+    if (
+        accumulator[REDUCE_LIMBS - 1] < 0x19999999
+        || (spacing < -11 && (
+            spacing + *scale >= 1
+            || (
+                spacing + *scale == 0
+                && reduced->high <= fixed_half.high
+            )
+        ))
+    ) {
+        *reduced = fixed_from_int(0);
+        *scale = 0;
+    }
+    if (quadrant < 0) {
+        quadrant = -quadrant;
+        *reduced = fixed_negate(*reduced);
+    }
+    if (coefficient < 0) {
+        quadrant = -quadrant;
+        *reduced = fixed_negate(*reduced);
+    }
+    return quadrant & 3;
+}
+
+static fixed square_scaled(fixed reduced, int64 scale) {
+/*
+    Square a reduced remainder, taking out the scale.
+*/
+    return fixed_divide_power(fixed_multiply(reduced, reduced), 2 * scale);
+}
+
+static fixed sine_series(fixed reduced, fixed square) {
+/*
+    sin(r) = r - r**3/3! + r**5/5! - ..., a polynomial in r**2 times r. With
+    |r| <= pi/4, 14 terms give more than 30 digits.
+*/
+    return fixed_multiply(
+        reduced,
+        polynomial(fixed_sine_coefficients, 13, square)
+    );
+}
+
+static fixed cosine_series(fixed square) {
+/*
+    cos(r) = 1 - r**2/2! + r**4/4! - ..., a polynomial in r**2.
+*/
+    return polynomial(fixed_cosine_coefficients, 14, square);
+}
+
+static int is_tiny(dec64 number) {
+/*
+    If |number| < 1e-9, then sin, tan, asin, and atan are the number itself,
+    and cos is 1.
+*/
+    int64 coefficient = dec64_coefficient(number);
+    return (
+        coefficient == 0
+        || dec64_exponent(number) + count_digits(
+            coefficient < 0
+            ? -coefficient
+            : coefficient
+        ) <= -9
+    );
+}
+
+static fixed fixed_mantissa(dec64 number, int64* scale) {
+/*
+    Take |number| = mantissa * 10**scale, where 1 <= mantissa < 10.
+*/
+    int64 coefficient = dec64_coefficient(number);
+    int64 nr_digits;
+
+    if (coefficient < 0) {
+        coefficient = -coefficient;
+    }
+    nr_digits = count_digits(coefficient);
+    *scale = dec64_exponent(number) + nr_digits - 1;
+    return fixed_from_decimal(coefficient, 1 - nr_digits);
+}
+
+static fixed atan_series(fixed slope) {
+/*
+    atan(t) for 0 <= t <= 1. With c = k/8 the nearest eighth,
+
+        atan(t) = atan(c) + atan(z)     where z = (t - c) / (1 + t * c)
+
+    and |z| < 1/16, so 15 terms of the series of atan(z) are plenty.
+*/
+    fixed eighth;
+    int64 k;
+    int64 n;
+    fixed square;
+    fixed sum;
+    fixed z;
+
+    k = fixed_floor(fixed_add(fixed_multiply_int(slope, 8), fixed_half));
+    eighth = fixed_divide_int(fixed_from_int(k), 8);
+    z = fixed_divide(
+        fixed_subtract(slope, eighth),
+        fixed_add(fixed_one, fixed_multiply(slope, eighth))
+    );
+    square = fixed_multiply(z, z);
+    sum = fixed_divide_int(fixed_one, 29);
+    for (n = 13; n >= 0; n -= 1) {
+        COUNT(DEC64_MATH_SERIES, 1);
+        sum = fixed_subtract(
+            fixed_divide_int(fixed_one, 2 * n + 1),
+            fixed_multiply(square, sum)
+        );
+    }
+    return fixed_add(fixed_atan_eighths[k], fixed_multiply(z, sum));
+}
+
+static fixed atan_ratio(fixed numerator, fixed denominator, int64 scale) {
+/*
+    The angle in [0, pi/2] whose tangent is numerator / denominator * 10**scale.
+    Both are positive. If the scale is not 0, then numerator / denominator
+    must be between 0.1 and 10. A ratio above 1 is turned over:
+
+        atan(x) = pi/2 - atan(1/x)
+*/
+    if (
+        scale > 0
+        || (scale == 0 && fixed_is_negative(fixed_subtract(denominator, numerator)))
+    ) {
+        return fixed_subtract(
+            fixed_half_pi,
+            atan_series(
+                fixed_divide_power(fixed_divide(denominator, numerator), scale)
+            )
+        );
+    }
+    return atan_series(
+        fixed_divide_power(fixed_divide(numerator, denominator), -scale)
+    );
+}
+
+static fixed asin_fixed(dec64 slope) {
+/*
+    asin(x) = atan(x / sqrt((1 - x) * (1 + x))), where -1 <= x <= 1.
+*/
+    fixed angle;
+    fixed cosine;
+    fixed x = fixed_from_dec64(dec64_abs(slope));
+
+    cosine = fixed_multiply(
+        fixed_subtract(fixed_one, x),
+        fixed_add(fixed_one, x)
+    );
+    angle = (
+        fixed_is_zero(cosine)
+        ? fixed_half_pi
+        : atan_ratio(x, fixed_sqrt(cosine), 0)
+    );
+    return (
+        slope < 0
+        ? fixed_negate(angle)
+        : angle
+    );
+}
+
+static int is_slope(dec64 slope) {
+/*
+    asin and acos are defined for -1 <= slope <= 1.
+*/
+    return (
+        dec64_is_nan(slope) == DEC64_FALSE
+        && dec64_is_less(DEC64_ONE, dec64_abs(slope)) == DEC64_FALSE
+    );
+}
+
+/* functions in service to gamma */
+
+static fixed stirling(fixed z) {
+/*
+    ln(gamma(z)) for z >= 24 by Stirling's series,
+
+        (z - 1/2) ln(z) - z + ln(2 pi) / 2 + 1/(12 z) - 1/(360 z**3) + ...
+
+    which to the 1/z**25 term is good to 30 digits.
+*/
+    fixed reciprocal = fixed_divide(fixed_one, z);
+
+    return fixed_add(
+        fixed_subtract(
+            fixed_multiply(fixed_subtract(z, fixed_half), fixed_log(z)),
+            z
+        ),
+        fixed_add(
+            fixed_half_log_2pi,
+            fixed_multiply(
+                reciprocal,
+                polynomial(
+                    fixed_stirling_coefficients,
+                    12,
+                    fixed_multiply(reciprocal, reciprocal)
+                )
+            )
+        )
+    );
+}
+
+static fixed lgamma_fixed(fixed x) {
+/*
+    ln(gamma(x)) for 1e-9 <= x < 1001. x is raised to at least 24 with
+
+        gamma(x) = gamma(x + n) / (x (x + 1) ... (x + n - 1))
+
+    The product is divided by 1000 whenever it passes 1000, so that it stays
+    in range, and the digits taken out are put back as logarithms.
+*/
+    fixed product = fixed_one;
+    int64 digits = 0;
+
+    while (fixed_floor(x) < 24) {
+        COUNT(DEC64_MATH_SHIFT, 1);
+        product = fixed_multiply(product, x);
+        x = fixed_add(x, fixed_one);
+        if (fixed_floor(product) >= 1000) {
+            product = fixed_divide_int(product, 1000);
+            digits += 3;
+        }
+    }
+    return fixed_subtract(
+        stirling(x),
+        fixed_add(
+            fixed_log(product),
+            fixed_multiply_int(fixed_ln10, digits)
+        )
+    );
+}
+
+static fixed lgamma_large(dec64 x, fixed extra, int64* scale) {
+/*
+    ln(gamma(x)) + extra for x >= 1000, as result * 10**scale. Writing Stirling
+    as
+
+        x (ln(x) - 1) + (ln(2 pi) - ln(x)) / 2 + 1/(12 x) - ...
+
+    the first term is the mantissa of x times ln(x) - 1, and the rest is small
+    enough to be scaled down and added to it.
+*/
+    fixed log = log_fixed(x);
+    fixed mantissa = fixed_mantissa(x, scale);
+    fixed reciprocal = fixed_divide_power(
+        fixed_divide(fixed_one, mantissa),
+        *scale
+    );
+    fixed rest = fixed_add(
+        fixed_add(
+            fixed_divide_int(fixed_subtract(
+                fixed_add(fixed_half_log_2pi, fixed_half_log_2pi),
+                log
+            ), 2),
+            extra
+        ),
+        fixed_multiply(
+            reciprocal,
+            polynomial(
+                fixed_stirling_coefficients,
+                12,
+                fixed_multiply(reciprocal, reciprocal)
+            )
+        )
+    );
+
+    return fixed_add(
+        fixed_multiply(mantissa, fixed_subtract(log, fixed_one)),
+        fixed_divide_power(rest, *scale)
+    );
+}
+
+static int gamma_log(dec64 x, fixed* result, int64* scale, int* negative) {
+/*
+    Compute ln|gamma(x)| as result * 10**scale, and tell if gamma(x) is
+    negative. The scale is 0 unless |x| >= 1000. It returns 0 if x is nan or
+    a pole: zero or a negative integer.
+
+    For a negative x, the reflection formula
+
+        gamma(x) = pi / (sin(pi x) gamma(1 - x))
+
+    is used, where sin(pi x) is found from the fraction f of x, which is
+    exact, as sin(pi f) or cos(pi (1/2 - f)), whichever has the smaller
+    argument.
+*/
+    fixed angle;
+    fixed fraction;
+    int64 floor;
+    int near;
+    fixed reflection;
+    fixed sine;
+    fixed value = fixed_zero;
+
+    *scale = 0;
+    *negative = 0;
+    if (
+        dec64_is_nan(x) == DEC64_TRUE
+        || dec64_is_zero(x) == DEC64_TRUE
+        || (x < 0 && dec64_is_integer(x) == DEC64_TRUE)
+    ) {
+        return 0;
+    }
+    if (is_tiny(x)) {
+
+/*
+    ln|gamma(x)| = -ln|x| - euler x + ...
+*/
+
+        *negative = x < 0;
+        *result = fixed_negate(fixed_add(
+            log_fixed(dec64_abs(x)),
+            fixed_multiply(fixed_euler, fixed_from_dec64(x))
+        ));
+        return 1;
+    }
+    if (x > 0) {
+        if (dec64_is_less(x, dec64_new(1000, 0)) == DEC64_TRUE) {
+            *result = lgamma_fixed(fixed_from_dec64(x));
+        } else {
+            *result = lgamma_large(x, fixed_zero, scale);
+        }
+        return 1;
+    }
+    near = dec64_is_less(dec64_new(-1000, 0), x) == DEC64_TRUE;
+    if (near) {
+        value = fixed_from_dec64(x);
+        floor = fixed_floor(value);
+        fraction = fixed_subtract(value, fixed_from_int(floor));
+    } else {
+        dec64 integer = dec64_normal(dec64_floor(x));
+        floor = dec64_coefficient(integer);
+        fraction = fixed_from_dec64(dec64_subtract(x, integer));
+    }
+    *negative = (floor & 1) != 0;
+    if (fraction.high >= fixed_half.high) {
+        fraction = fixed_subtract(fixed_one, fraction);
+    }
+    if (fraction.high < (fixed_half.high >> 1)) {
+        angle = fixed_multiply(fixed_pi, fraction);
+        sine = sine_series(angle, fixed_multiply(angle, angle));
+    } else {
+        angle = fixed_multiply(
+            fixed_pi,
+            fixed_subtract(fixed_half, fraction)
+        );
+        sine = cosine_series(fixed_multiply(angle, angle));
+    }
+    reflection = fixed_subtract(fixed_log_pi, fixed_log(sine));
+    if (near) {
+        *result = fixed_subtract(
+            reflection,
+            lgamma_fixed(fixed_subtract(fixed_one, value))
+        );
+    } else {
+        *result = fixed_negate(lgamma_large(
+            dec64_subtract(DEC64_ONE, x),
+            fixed_negate(reflection),
+            scale
+        ));
+    }
+    return 1;
+}
+
+static dec64 gamma_finish(fixed log, int64 scale, int negative) {
+/*
+    Deliver +/-e**(log * 10**scale), which is too big or too small for a
+    dec64 when the scale is not 0.
+*/
+    dec64 result;
+
+    if (scale > 0 || fixed_floor(fixed_abs(log)) >= 400) {
+        return (
+            fixed_is_negative(log)
+            ? DEC64_ZERO
+            : DEC64_NULL
+        );
+    }
+    result = exp_fixed(log);
+    return (
+        negative
+        ? dec64_neg(result)
+        : result
+    );
+}
+
+dec64 dec64_acos(dec64 slope) {
+    if (!is_slope(slope)) {
+        return DEC64_NULL;
+    }
+    return fixed_pack(fixed_subtract(fixed_half_pi, asin_fixed(slope)), 0);
+}
+
+dec64 dec64_asin(dec64 slope) {
+    if (!is_slope(slope)) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(slope)) {
+        return slope;
+    }
+    return fixed_pack(asin_fixed(slope), 0);
+}
+
+dec64 dec64_atan(dec64 slope) {
+    fixed angle;
+    fixed mantissa;
+    int64 scale;
+
+    if (dec64_is_nan(slope) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(slope)) {
+        return slope;
+    }
+    mantissa = fixed_mantissa(slope, &scale);
+    angle = atan_ratio(mantissa, fixed_one, scale);
+    return fixed_pack(
+        slope < 0
+        ? fixed_negate(angle)
+        : angle,
+        0
+    );
+}
+
+dec64 dec64_atan2(dec64 y, dec64 x) {
+/*
+    The angle of the point (x, y), between -pi and pi.
+*/
+    fixed angle;
+    fixed x_mantissa;
+    int64 x_scale;
+    fixed y_mantissa;
+    int64 y_scale;
+
+    if (dec64_is_nan(x) == DEC64_TRUE || dec64_is_nan(y) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (dec64_is_zero(y) == DEC64_TRUE) {
+        if (dec64_is_zero(x) == DEC64_TRUE) {
+            return DEC64_NULL;
+        }
+        return (
+            x < 0
+            ? fixed_pack(fixed_pi, 0)
+            : DEC64_ZERO
+        );
+    }
+    if (dec64_is_zero(x) == DEC64_TRUE) {
+        return fixed_pack(
+            y < 0
+            ? fixed_negate(fixed_half_pi)
+            : fixed_half_pi,
+            0
+        );
+    }
+    y_mantissa = fixed_mantissa(y, &y_scale);
+    x_mantissa = fixed_mantissa(x, &x_scale);
+
+/*
+    If |y / x| < 1e-9 and x is positive, the angle is just y / x.
+*/
+
+    if (x > 0 && y_scale - x_scale <= -10) {
+        angle = fixed_divide(y_mantissa, x_mantissa);
+        return fixed_pack(
+            y < 0
+            ? fixed_negate(angle)
+            : angle,
+            y_scale - x_scale
+        );
+    }
+    angle = atan_ratio(y_mantissa, x_mantissa, y_scale - x_scale);
+    if (x < 0) {
+        angle = fixed_subtract(fixed_pi, angle);
+    }
+    return fixed_pack(
+        y < 0
+        ? fixed_negate(angle)
+        : angle,
+        0
+    );
+}
+
+dec64 dec64_binomial(dec64 n, dec64 k) {
+/*
+    The number of ways of choosing k things from n things, n! / (k! (n - k)!),
+    for integers 0 <= k <= n. It is computed as
+
+        n (n - 1) ... (n - k + 1) / k!
+
+    in two words while that fits, which is exact. Otherwise the numerator and
+    the denominator are formed in wides and divided, so the result is not
+    limited by the range of the factorials.
+*/
+    int64 at;
+    uint64 denominator[2];
+    int64 denominator_exponent;
+    uint64 factor[2];
+    int64 exponent = 0;
+    uint64 high;
+    int inexact = 0;
+    int64 length;
+    int64 number;
+    uint64 numerator[2];
+    int64 numerator_exponent;
+    uint64 result[3] = {1, 0, 0};
+
+    n = dec64_normal(n);
+    k = dec64_normal(k);
+    if (
+        dec64_is_nan(n) == DEC64_TRUE
+        || dec64_is_nan(k) == DEC64_TRUE
+        || dec64_exponent(n) != 0
+        || dec64_exponent(k) != 0
+        || n < 0
+        || k < 0
+    ) {
+        return DEC64_NULL;
+    }
+    number = dec64_coefficient(n);
+    length = dec64_coefficient(k);
+    if (length > number) {
+        return DEC64_ZERO;
+    }
+    if (length > number - length) {
+        length = number - length;
+    }
+
+/*
+    C(n, k) >= 2**k, so a k larger than 480 overflows.
+*/
+
+    if (length > 480) {
+        return DEC64_NULL;
+    }
+
+/*
+    Each step forms C(n, at + 1) from C(n, at), which divides exactly.
+*/
+
+    for (at = 0; at < length; at += 1) {
+        multiply_64(result[1], (uint64)(number - at), &result[2], &result[1]);
+        multiply_64(result[0], (uint64)(number - at), &high, &result[0]);
+        add_word(result, 1, high);
+        divide_words(result, 3, (uint64)(at + 1));
+        if (result[2] != 0) {
+            break;
+        }
+    }
+    if (at == length) {
+        if (result[1] == 0 && result[0] <= 36028797018963967ULL) {
+            return dec64_new((int64)result[0], 0);
+        }
+
+/*
+    Take the leading 18 digits and round. Only the first digit that is dropped
+    matters to a rounding that goes half away from zero.
+*/
+
+        while (result[1] != 0 || result[0] >= (uint64)power[18]) {
+            divide_words(result, 2, 10);
+            exponent += 1;
+        }
+        return pack_digits(0, result[0], exponent);
+    }
+    numerator_exponent = wide_from_integer((uint64)number, numerator);
+    denominator_exponent = wide_from_integer(1, denominator);
+    for (at = 1; at < length; at += 1) {
+        numerator_exponent += wide_from_integer(
+            (uint64)(number - at),
+            factor
+        );
+        numerator_exponent += wide_multiply(
+            numerator,
+            factor,
+            numerator,
+            &inexact
+        );
+        denominator_exponent += wide_from_integer((uint64)(at + 1), factor);
+        denominator_exponent += wide_multiply(
+            denominator,
+            factor,
+            denominator,
+            &inexact
+        );
+    }
+    return fixed_pack(
+        fixed_divide(wide_mantissa(numerator), wide_mantissa(denominator)),
+        numerator_exponent - denominator_exponent
+    );
+}
+
+dec64 dec64_cos(dec64 radians) {
+    int64 quadrant;
+    fixed reduced;
+    int64 scale;
+    fixed square;
+
+    if (dec64_is_nan(radians) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(radians)) {
+        return DEC64_ONE;
+    }
+    quadrant = reduce_radians(radians, &reduced, &scale);
+    square = square_scaled(reduced, scale);
+    switch (quadrant) {
+    case 0:
+        return fixed_pack(cosine_series(square), 0);
+    case 1:
+        return fixed_pack(fixed_negate(sine_series(reduced, square)), -scale);
+    case 2:
+        return fixed_pack(fixed_negate(cosine_series(square)), 0);
+    default:
+        return fixed_pack(sine_series(reduced, square), -scale);
+    }
+}
+
+dec64 dec64_exp(dec64 exponent) {
+    dec64 result;
+
+    if (exp_special(exponent, &result)) {
+        return result;
+    }
+    return exp_fixed(fixed_from_dec64(exponent));
+}
+
+dec64 dec64_pow10(dec64 exponent) {
+/*
+    10**n is a single dec64_new when n is an integer.
+*/
+    int64 integer;
+    int odd;
+
+    if (
+        dec64_is_nan(exponent) == DEC64_FALSE
+        && is_integer(exponent, &integer, &odd)
+        && integer != 0
+    ) {
+        return dec64_new(1, integer);
+    }
+    return dec64_raise(dec64_new(10, 0), exponent);
+}
+
+dec64 dec64_raise(dec64 coefficient, dec64 exponent) {
+/*
+    An integer exponent up to 2**16 is done exactly with raise_integer. Other
+    exponents use e**(exponent * ln(coefficient)), with the product kept in
+    fixed point.
+*/
+    int64 integer = 0;
+    int negative = 0;
+    int odd;
+    fixed product;
+    int64 scale;
+
+    if (dec64_is_zero(exponent) == DEC64_TRUE) {
+        return DEC64_ONE;
+    }
+    if (
+        dec64_is_nan(coefficient) == DEC64_TRUE
+        || dec64_is_nan(exponent) == DEC64_TRUE
+    ) {
+        return DEC64_NULL;
+    }
+    if (dec64_is_zero(coefficient) == DEC64_TRUE) {
+        return (
+            exponent < 0
+            ? DEC64_NULL
+            : DEC64_ZERO
+        );
+    }
+    if (is_integer(exponent, &integer, &odd)) {
+        if (integer != 0) {
+            return raise_integer(
+                dec64_coefficient(coefficient),
+                dec64_exponent(coefficient),
+                integer
+            );
+        }
+        negative = coefficient < 0 && odd;
+    } else if (coefficient < 0) {
+        return DEC64_NULL;
+    }
+
+/*
+    Form exponent * ln(coefficient), scaling it by the exponent's power of ten
+    a digit at a time so that an overflow is caught before it happens.
+*/
+
+    product = fixed_multiply(
+        log_fixed(dec64_abs(coefficient)),
+        fixed_mantissa(exponent, &scale)
+    );
+    if (exponent < 0) {
+        product = fixed_negate(product);
+    }
+    while (scale > 0 && fixed_floor(fixed_abs(product)) < 1000) {
+        product = fixed_multiply_int(product, 10);
+        scale -= 1;
+    }
+    product = fixed_divide_power(product, -scale);
+    if (fixed_floor(fixed_abs(product)) >= 400) {
+        return (
+            fixed_is_negative(product)
+            ? DEC64_ZERO
+            : DEC64_NULL
+        );
+    }
+    return (
+        negative
+        ? dec64_neg(exp_fixed(product))
+        : exp_fixed(product)
+    );
+}
+
+dec64 dec64_factorial(dec64 x) {
+/*
+    The factorials of the integers come from the table. Other numbers have
+    x! = gamma(x + 1) = x gamma(x).
+*/
+    int negative;
+    dec64 n = dec64_normal(x);
+    int64 c = dec64_coefficient(n);
+    fixed log;
+    int64 scale;
+
+    if (dec64_exponent(n) == 0) {
+        if (c >= 0 && c < FAC) {
+            return factorials[c];
+        }
+        return DEC64_NULL;
+    }
+    if (dec64_is_nan(x) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(x)) {
+
+/*
+    ln(gamma(1 + x)) = -euler x + (pi**2 / 12) x**2 - ...
+*/
+
+        fixed value = fixed_from_dec64(x);
+        return exp_fixed(fixed_multiply(value, fixed_subtract(
+            fixed_multiply(
+                fixed_divide_int(fixed_multiply(fixed_pi, fixed_pi), 12),
+                value
+            ),
+            fixed_euler
+        )));
+    }
+    if (!gamma_log(x, &log, &scale, &negative)) {
+        return DEC64_NULL;
+    }
+    if (scale == 0) {
+        log = fixed_add(log, log_fixed(dec64_abs(x)));
+        negative ^= x < 0;
+    }
+    return gamma_finish(log, scale, negative);
+}
+
+dec64 dec64_gamma(dec64 x) {
+/*
+    The gamma function. gamma(n) = (n - 1)! for a positive integer n, and it
+    has poles at zero and the negative integers, where it is nan.
+*/
+    int negative;
+    dec64 n = dec64_normal(x);
+    int64 c = dec64_coefficient(n);
+    fixed log;
+    int64 scale;
+
+    if (dec64_exponent(n) == 0 && c > 0 && c <= FAC) {
+        return factorials[c - 1];
+    }
+    if (!gamma_log(x, &log, &scale, &negative)) {
+        return DEC64_NULL;
+    }
+    return gamma_finish(log, scale, negative);
+}
+
+dec64 dec64_lgamma(dec64 x) {
+/*
+    ln|gamma(x)|, which is nan at the poles of gamma. It is 0 at 1 and 2.
+*/
+    int negative;
+    fixed log;
+    int64 scale;
+
+    if (
+        dec64_is_equal(x, DEC64_ONE) == DEC64_TRUE
+        || dec64_is_equal(x, dec64_new(2, 0)) == DEC64_TRUE
+    ) {
+        return DEC64_ZERO;
+    }
+    if (!gamma_log(x, &log, &scale, &negative)) {
+        return DEC64_NULL;
+    }
+    return fixed_pack(log, scale);
+}
+
+dec64 dec64_log(dec64 x) {
+/*
+    ln(x) = decimal * ln(10) + ln(m)
+*/
+    fixed base;
+    int64 decimal;
+    dec64 result;
+    fixed z;
+
+    if (log_special(x, &result)) {
+        return result;
+    }
+    if (log_reduce(x, &decimal, &base, &z)) {
+        return log_near_one(x, fixed_one);
+    }
+    return fixed_pack(
+        fixed_add(
+            fixed_multiply_int(fixed_ln10, decimal),
+            log_mantissa(base, z)
+        ),
+        0
+    );
+}
+
+dec64 dec64_log10(dec64 x) {
+/*
+    log10(x) = decimal + ln(m) * log10(e)
+
+    The result is exact for powers of ten.
+*/
+    fixed base;
+    int64 decimal;
+    dec64 result;
+    fixed z;
+
+    if (log_special(x, &result)) {
+        return result;
+    }
+    if (log_reduce(x, &decimal, &base, &z)) {
+        return log_near_one(x, fixed_log10_e);
+    }
+    return fixed_pack(
+        fixed_add(
+            fixed_from_int(decimal),
+            fixed_multiply(log_mantissa(base, z), fixed_log10_e)
+        ),
+        0
+    );
+}
+
+dec64 dec64_log2(dec64 x) {
+/*
+    log2(x) = (decimal * ln(10) + ln(m)) * log2(e)
+
+    The result is exact for powers of two that fit in a coefficient.
+*/
+    fixed base;
+    int64 decimal;
+    dec64 result;
+    fixed z;
+
+    if (log_special(x, &result)) {
+        return result;
+    }
+    if (log_reduce(x, &decimal, &base, &z)) {
+        return log_near_one(x, fixed_log2_e);
+    }
+    return fixed_pack(
+        fixed_multiply(
+            fixed_add(
+                fixed_multiply_int(fixed_ln10, decimal),
+                log_mantissa(base, z)
+            ),
+            fixed_log2_e
+        ),
+        0
+    );
+}
+
+/*
+    The random state used by dec64_random. It can be set by dec64_seed.
+    Programs with more than one thread should give each thread its own state
+    object instead.
+*/
+
+static struct dec64_random_state random_state = {CONFIRMED, 0, D_E, D_2PI};
+
+static int random_valid(dec64_random_state state) {
+    return state != NULL && state->valid == CONFIRMED;
+}
+
+static void random_seed(
+    dec64_random_state state,
+    uint64 part_0,
+    uint64 part_1
+) {
+    state->part_0 = part_0;
+    state->part_1 = part_1;
+    if ((part_0 | part_1) == 0) {
+        state->part_1 = 1;
+    }
+}
+
+static uint64 random_step(dec64_random_state state) {
+/*
+    Advance the state by one step of xorshift128+ and return its output.
+*/
+    uint64 s1 = state->part_0;
+    uint64 s0 = state->part_1;
+    s1 ^= s1 << 23;
+    s1 ^= s0 ^ (s0 >> 5) ^ (s1 >> 18);
+    state->part_0 = s0;
+    state->part_1 = s1;
+    return s1 + s0;
+}
+
+/*
+    The ziggurat tables of Marsaglia and Tsang, in the arrangement of Doornik.
+    Each distribution is covered by layers of equal area. x[i] is the right
+    edge of layer i, except that x[0] is the width of a rectangle having the
+    area of the base layer with its tail. Most samples fall inside of a layer's
+    rectangle and take only one random step and one multiply.
+*/
+
+#define ZIGGURAT_NORMAL_R       3.442619855899
+#define ZIGGURAT_EXPONENTIAL_R  7.69711747013104972
+
+static const double random_normal_x[129] = {
+    3.7130862467425505, 3.4426198558990002, 3.2230849845811416,
+    3.0832288582168683, 2.9786962526477803, 2.8943440070215289,
+    2.8231253505489105, 2.7611693723871769, 2.7061135731218195,
+    2.6564064112613597, 2.6109722484318474, 2.5690336259249378,
+    2.5300096723888275, 2.4934545220953721, 2.4590181774118305,
+    2.4264206455337498, 2.3954342780110625, 2.3658713701176386,
+    2.3375752413392368, 2.310413683698763, 2.2842740596774718,
+    2.2590595738691985, 2.2346863955909795, 2.2110814088787034,
+    2.1881804320760492, 2.1659267937489219, 2.1442701823603953,
+    2.1231657086739766, 2.1025731351892385, 2.0824562379920168,
+    2.0627822745083084, 2.0435215366550676, 2.0246469733773855,
+    2.0061338699634721, 1.9879595741276199, 1.9701032608543265,
+    1.9525457295535567, 1.9352692282966228, 1.9182573008645099,
+    1.9014946531051511, 1.884967035707759, 1.8686611409944887,
+    1.8525645117280911, 1.836665460258446, 1.8209529965961255,
+    1.8054167642192285, 1.7900469825998586, 1.7748343955860695,
+    1.7597702248995934, 1.7448461281138004, 1.7300541605637305,
+    1.7153867407136676, 1.7008366185699169, 1.6863968467791681,
+    1.6720607540976009, 1.6578219209540241, 1.6436741568628686,
+    1.6296114794706347, 1.615628095043161, 1.6017183802213781,
+    1.5878768648905761, 1.5740982160230008, 1.5603772223661689,
+    1.5467087798599104, 1.5330878776740433, 1.5195095847659401,
+    1.5059690368632033, 1.492461423781354, 1.4789819769899242,
+    1.4655259573427108, 1.4520886428892246, 1.4386653166845635,
+    1.4252512545140601, 1.4118417124470577, 1.3984319141310053,
+    1.3850170377326518, 1.3715922024273426, 1.3581524543301435,
+    1.344692751753547, 1.3312079496656273, 1.3176927832094141,
+    1.3041418501286168, 1.2905495919261964, 1.2769102735601556,
+    1.2632179614546211, 1.2494664995730682, 1.2356494832633627,
+    1.2217602305399964, 1.2077917504159497, 1.1937367078331287,
+    1.1795873846639882, 1.1653356361647524, 1.1509728421488674,
+    1.1364898520131608, 1.1218769225825422, 1.107123647534036,
+    1.0922188769072774, 1.0771506248928957, 1.0619059636948243,
+    1.0464709007640454, 1.0308302360681956, 1.0149673952513305,
+    0.99886423349298359, 0.98250080351542901, 0.9658550794011499,
+    0.94890262551130644, 0.93161619661515083, 0.91396525102303228,
+    0.89591535258093769, 0.87742742911292337, 0.85845684319381321,
+    0.83895221429757738, 0.81885390670035729, 0.79809206064405691,
+    0.77658398789475991, 0.75423066445405562, 0.73091191064248884,
+    0.70647961133543646, 0.68074791866915463, 0.65347863873997525,
+    0.6243585973360507, 0.59296294247144832, 0.55869217840818519,
+    0.52065603876206057, 0.47743783729668982, 0.42654798635542351,
+    0.36287143109703196, 0.27232086481396467, 0.0
+};
+
+static const double random_exponential_x[257] = {
+    8.6971174701310527, 7.6971174701310501, 6.9410336293772126,
+    6.4783784938325697, 6.1441646657724727, 5.8821443157953999,
+    5.6664101674540337, 5.4828906275260625, 5.323090505754398,
+    5.1814872813015, 5.0542884899813041, 4.9387770859012505,
+    4.832939741025112, 4.7352429966017411, 4.6444918854200852,
+    4.5597370617073514, 4.4802117465284219, 4.4052876934735732,
+    4.334443680317273, 4.2672424802773659, 4.2033137137351844,
+    4.1423408656640515, 4.0840513104082978, 4.0282085446479368,
+    3.9746060666737888, 3.9230625001354897, 3.8734176703995091,
+    3.8255294185223367, 3.7792709924116679, 3.7345288940397974,
+    3.6912010902374188, 3.6491955157608538, 3.6084288131289095,
+    3.568825265648337, 3.5303158891293434, 3.4928376547740596,
+    3.4563328211327602, 3.4207483572511199, 3.386035442460301,
+    3.3521490309001094, 3.319047470970748, 3.2866921715990687,
+    3.2550473085704499, 3.2240795652862642, 3.1937579032122403,
+    3.1640533580259729, 3.1349388580844404, 3.1063890623398245,
+    3.0783802152540902, 3.0508900166154551, 3.0238975044556766,
+    2.9973829495161306, 2.9713277599210897, 2.9457143948950457,
+    2.9205262865127408, 2.8957477686001418, 2.8713640120155364,
+    2.8473609656351888, 2.8237253024500353, 2.8004443702507378,
+    2.7775061464397566, 2.7548991965623446, 2.7326126361947001,
+    2.7106360958679288, 2.6889596887418037, 2.6675739807732666,
+    2.6464699631518092, 2.6256390267977885, 2.6050729387408356,
+    2.5847638202141408, 2.5647041263169053, 2.54488662711187,
+    2.525304390037828, 2.505950763528594, 2.4868193617402095,
+    2.4679040502973648, 2.4491989329782498, 2.4306983392644197,
+    2.4123968126888706, 2.3942890999214579, 2.3763701405361406,
+    2.3586350574093373, 2.3410791477030344, 2.3236978743901964,
+    2.3064868582835798, 2.2894418705322694, 2.2725588255531548,
+    2.2558337743672192, 2.239262898312909, 2.2228425031110368,
+    2.2065690132576639, 2.19043896672322, 2.1744490099377747,
+    2.158595893043886, 2.142876465399842, 2.1272876713173683,
+    2.1118265460190422, 2.096490211801715, 2.0812758743932251,
+    2.0661808194905755, 2.0512024094685848, 2.0363380802487696,
+    2.0215853383189262, 2.0069417578945186, 1.9924049782135766,
+    1.9779727009573604, 1.9636426877895483, 1.9494127580071849,
+    1.9352807862970514, 1.9212447005915281, 1.9073024800183875,
+    1.8934521529393082, 1.8796917950722112, 1.866019527692828,
+    1.8524335159111756, 1.83893196701888, 1.8255131289035198,
+    1.8121752885263906, 1.7989167704602909, 1.785735935484126,
+    1.7726311792313056, 1.7596009308890748, 1.7466436519460744,
+    1.7337578349855716, 1.7209420025219353, 1.7081947058780578,
+    1.6955145241015379, 1.6829000629175539, 1.6703499537164521,
+    1.6578628525741728, 1.6454374393037237, 1.6330724165359913,
+    1.6207665088282579, 1.6085184617988584, 1.5963270412864834,
+    1.5841910325326889, 1.5721092393862297, 1.5600804835278881,
+    1.5481036037145135, 1.5361774550410321, 1.5243009082192263,
+    1.5124728488721171, 1.5006921768428167, 1.4889578055167461,
+    1.4772686611561339, 1.4656236822457454, 1.4540218188487934,
+    1.4424620319720125, 1.4309432929388797, 1.4194645827699832,
+    1.4080248915695357, 1.3966232179170421, 1.385258568263122,
+    1.3739299563284906, 1.3626364025050868, 1.3513769332583352,
+    1.3401505805295046, 1.3289563811371166, 1.3177933761763247,
+    1.3066606104151741, 1.295557131686601, 1.2844819902750126,
+    1.2734342382962411, 1.2624129290696153, 1.2514171164808525,
+    1.2404458543344066, 1.2294981956938491, 1.2185731922087901,
+    1.2076698934267611, 1.1967873460884031, 1.1859245934042022,
+    1.1750806743109117, 1.1642546227056789, 1.1534454666557747,
+    1.1426522275816728, 1.1318739194110785, 1.1211095477013302,
+    1.110358108727411, 1.0996185885325973, 1.0888899619385468,
+    1.0781711915113723, 1.0674612264799677, 1.0567590016025514,
+    1.0460634359770442, 1.0353734317905285, 1.0246878730026172,
+    1.0140056239570965, 1.0033255279156967, 0.9926464055072759,
+    0.9819670530850626, 0.97128624098390326, 0.96060271166866651,
+    0.94991517776407597, 0.93922231995526229, 0.92852278474721039,
+    0.91781518207004431, 0.90709808271569026, 0.89637001558988993,
+    0.88562946476175153, 0.87487486629102507, 0.86410460481100448,
+    0.85331700984237335, 0.84251035181036849, 0.83168283773427321,
+    0.82083260655441181, 0.80995772405741828, 0.79905617735548717,
+    0.78812586886949243, 0.77716460975912971, 0.76617011273543467,
+    0.75513998418198225, 0.7440717155005081, 0.7329626735843654,
+    0.7218100903087562, 0.71061105090965504, 0.69936248110323196,
+    0.68806113277374781, 0.67670356802952258, 0.66528614139267794,
+    0.65380497984766495, 0.64225596042453637, 0.63063468493349029,
+    0.61893645139487607, 0.60715622162030003, 0.59528858429150289,
+    0.58332771274876949, 0.57126731653258833, 0.55910058551154063,
+    0.54682012516331058, 0.5344178812371656, 0.52188505159213505,
+    0.5092119824436544, 0.49638804551867116, 0.48340149165346186,
+    0.47023927508216901, 0.45688684093142024, 0.4433278660735524,
+    0.4295439402254107, 0.41551416960035636, 0.40121467889627777,
+    0.38661797794111957, 0.37169214532991723, 0.35639976025839382,
+    0.34069648106484912, 0.32452911701690945, 0.30783295467493216,
+    0.29052795549123039, 0.2725131854784647, 0.25365836338591202,
+    0.23379048305967473, 0.21267151063096662, 0.18995868962243184,
+    0.16512762256418728, 0.13730498094001259, 0.10483850756581878,
+    0.06385216381500157, 0.0
+};
+
+static double random_double(uint64 random) {
+/*
+    Turn the high 53 bits of a random word into a double between 0 and 1,
+    excluding both 0 and 1, so that its logarithm is finite.
+*/
+    return ((double)(random >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+static uint64 random_below(dec64_random_state state, uint64 range) {
+/*
+    Return an integer between 0 and range - 1 with no bias, by Lemire's
+    method: the high word of random * range is the result, and the low word
+    tells when the random word fell into the short remainder and must be
+    rejected. The threshold is less than range, so the division that finds it
+    is needed only in the rare case that the low word is too.
+*/
+    uint64 high;
+    uint64 low;
+    uint64 threshold;
+
+    multiply_64(random_step(state), range, &high, &low);
+    if (low < range) {
+        threshold = (0 - range) % range;
+        while (low < threshold) {
+            multiply_64(random_step(state), range, &high, &low);
+        }
+    }
+    return high;
+}
+
+static double random_normal(dec64_random_state state) {
+    while (1) {
+        uint64 random = random_step(state);
+        int layer = (int)(random >> 3) & 127;
+        double u = 2.0 * random_double(random) - 1.0;
+        double x = u * random_normal_x[layer];
+        double top;
+        double bottom;
+
+        if (fabs(x) < random_normal_x[layer + 1]) {
+            return x;
+        }
+        if (layer == 0) {
+
+/*
+    The tail beyond R is sampled by Marsaglia's method.
+*/
+
+            double y;
+            do {
+                x = log(random_double(random_step(state)))
+                    / ZIGGURAT_NORMAL_R;
+                y = log(random_double(random_step(state)));
+            } while (-2.0 * y < x * x);
+            return (
+                u < 0
+                ? x - ZIGGURAT_NORMAL_R
+                : ZIGGURAT_NORMAL_R - x
+            );
+        }
+
+/*
+    x falls outside of the layer's rectangle, in the wedge under the curve.
+*/
+
+        top = exp(-0.5 * (
+            random_normal_x[layer] * random_normal_x[layer] - x * x
+        ));
+        bottom = exp(-0.5 * (
+            random_normal_x[layer + 1] * random_normal_x[layer + 1] - x * x
+        ));
+        if (
+            bottom
+            + random_double(random_step(state)) * (top - bottom)
+            < 1.0
+        ) {
+            return x;
+        }
+    }
+}
+
+static double random_exponential(dec64_random_state state) {
+    while (1) {
+        uint64 random = random_step(state);
+        int layer = (int)(random >> 3) & 255;
+        double x = random_double(random) * random_exponential_x[layer];
+        double top;
+        double bottom;
+
+        if (x < random_exponential_x[layer + 1]) {
+            return x;
+        }
+        if (layer == 0) {
+
+/*
+    The exponential distribution has no memory, so its tail beyond R is R
+    plus another sample.
+*/
+
+            return (
+                ZIGGURAT_EXPONENTIAL_R
+                - log(random_double(random_step(state)))
+            );
+        }
+        top = exp(x - random_exponential_x[layer]);
+        bottom = exp(x - random_exponential_x[layer + 1]);
+        if (
+            bottom
+            + random_double(random_step(state)) * (top - bottom)
+            < 1.0
+        ) {
+            return x;
+        }
+    }
+}
+
+dec64 dec64_random() {
+/*
+    Return a number between 0 and 1 containing 16 randomy digits.
+    It uses xorshift128+.
+*/
+    return dec64_random_next(&random_state);
+}
+
+dec64_random_state dec64_random_begin(uint64 part_0, uint64 part_1) {
+/*
+    Create a random state object seeded with any 128 bits. It can return NULL
+    if memory allocation fails.
+*/
+    dec64_random_state state = (
+        (dec64_random_state)malloc(sizeof (struct dec64_random_state))
+    );
+    if (state != NULL) {
+        dec64_random_init(state, part_0, part_1);
+        state->allocated = 1;
+    }
+    return state;
+}
+
+void dec64_random_copy(
+    dec64_random_state destination,
+    dec64_random_state source
+) {
+/*
+    Make the destination produce the same sequence as the source. Copying a
+    state and then jumping the copy is how to make streams for other threads.
+    Like dec64_random_init, the destination is treated as fresh memory provided
+    by the caller, so it should not be a state made by dec64_random_begin. If
+    the source is not a valid state object, the destination is not changed.
+*/
+    if (
+        destination != NULL
+        && destination != source
+        && random_valid(source)
+    ) {
+        destination->allocated = 0;
+        destination->part_0 = source->part_0;
+        destination->part_1 = source->part_1;
+        destination->valid = CONFIRMED;
+    }
+}
+
+void dec64_random_end(dec64_random_state state) {
+/*
+    Dispose of the state object. The memory is freed only if the state object
+    was made by dec64_random_begin.
+*/
+    if (random_valid(state)) {
+        state->valid = 0;
+        if (state->allocated) {
+            free(state);
+        }
+    }
+}
+
+dec64 dec64_random_exponential(dec64_random_state state) {
+/*
+    Return a number from the exponential distribution with a mean of 1.
+    It has the precision of a double. If the state is not valid, the result is
+    nan.
+*/
+    if (!random_valid(state)) {
+        return DEC64_NULL;
+    }
+    return fixed_pack(fixed_from_double(random_exponential(state)), 0);
+}
+
+void dec64_random_exponential_n(
+    dec64_random_state state,
+    dec64 results[],
+    int64 length
+) {
+    int64 at;
+
+    for (at = 0; at < length; at += 1) {
+        results[at] = dec64_random_exponential(state);
+    }
+}
+
+void dec64_random_init(
+    dec64_random_state state,
+    uint64 part_0,
+    uint64 part_1
+) {
+/*
+    Seed a random state object in memory provided by the caller. It takes any
+    128 bits as the seed value. The seed must contain at least one 1 bit. The
+    memory is not read, so it need not be initialized. A state initialized
+    this way does not need to be passed to dec64_random_end, but it may be. To
+    reseed a state that is already in use, use dec64_random_reseed.
+*/
+    if (state != NULL) {
+        state->allocated = 0;
+        random_seed(state, part_0, part_1);
+        state->valid = CONFIRMED;
+    }
+}
+
+void dec64_random_jump(dec64_random_state state) {
+/*
+    Advance the state by 2**64 steps, as though random_step had been called
+    that many times. A state that has been jumped k times will not overlap the
+    original for at least 2**64 steps, so each thread of a parallel Monte Carlo
+    run can take the seed, jump by its thread number, and get a stream that is
+    reproducible and independent of the others.
+
+    The jump is the polynomial x**(2**64) reduced by the characteristic
+    polynomial of xorshift128+ (23, 18, 5). For each of its 1 bits, the
+    current state is added into the result.
+*/
+    static const uint64 jump[2] = {
+        0x8A5CD789635D2DFFULL,
+        0x121FD2155C472F96ULL
+    };
+    uint64 part_0 = 0;
+    uint64 part_1 = 0;
+    int word;
+    int bit;
+
+    if (!random_valid(state)) {
+        return;
+    }
+    for (word = 0; word < 2; word += 1) {
+        for (bit = 0; bit < 64; bit += 1) {
+            if ((jump[word] >> bit) & 1) {
+                part_0 ^= state->part_0;
+                part_1 ^= state->part_1;
+            }
+            random_step(state);
+        }
+    }
+    state->part_0 = part_0;
+    state->part_1 = part_1;
+}
+
+void dec64_random_n(dec64_random_state state, dec64 results[], int64 length) {
+/*
+    Fill the results with numbers from the state. They are the same numbers
+    that length calls to dec64_random_next would produce.
+*/
+    int64 at;
+
+    for (at = 0; at < length; at += 1) {
+        results[at] = dec64_random_next(state);
+    }
+}
+
+dec64 dec64_random_next(dec64_random_state state) {
+/*
+    Return a number between 0 and 1 containing 16 randomy digits. If the state
+    is not valid, the result is nan.
+*/
+    if (!random_valid(state)) {
+        return DEC64_NULL;
+    }
+    while (1) {
+        uint64 mantissa = random_step(state) >> 10;
+/*
+    mantissa contains an integer between 0 and 18014398509481983.
+    If it is less than or equal to 9999999999999999 then we are done.
+*/
+        if (mantissa <= 9999999999999999LL) {
+            return dec64_new(mantissa, -16);
+        }
+    }
+}
+
+dec64 dec64_random_normal(dec64_random_state state) {
+/*
+    Return a number from the normal distribution with a mean of 0 and a
+    standard deviation of 1. It has the precision of a double. If the state is
+    not valid, the result is nan.
+*/
+    if (!random_valid(state)) {
+        return DEC64_NULL;
+    }
+    return fixed_pack(fixed_from_double(random_normal(state)), 0);
+}
+
+void dec64_random_normal_n(
+    dec64_random_state state,
+    dec64 results[],
+    int64 length
+) {
+    int64 at;
+
+    for (at = 0; at < length; at += 1) {
+        results[at] = dec64_random_normal(state);
+    }
+}
+
+dec64 dec64_random_range(dec64_random_state state, dec64 low, dec64 high) {
+/*
+    Return an integer that is at least low and less than high, with every
+    integer in the range equally likely. low and high must be integers that
+    can be written with an exponent of 0, and low must be less than high, and
+    the state must be valid. Otherwise the result is nan.
+*/
+    int64 high_coefficient;
+    int64 low_coefficient;
+
+    if (!random_valid(state)) {
+        return DEC64_NULL;
+    }
+    low = dec64_normal(low);
+    high = dec64_normal(high);
+    if (
+        dec64_is_nan(low) == DEC64_TRUE
+        || dec64_is_nan(high) == DEC64_TRUE
+        || dec64_exponent(low) != 0
+        || dec64_exponent(high) != 0
+    ) {
+        return DEC64_NULL;
+    }
+    low_coefficient = dec64_coefficient(low);
+    high_coefficient = dec64_coefficient(high);
+    if (low_coefficient >= high_coefficient) {
+        return DEC64_NULL;
+    }
+    return dec64_new(
+        low_coefficient + (int64)random_below(
+            state,
+            (uint64)(high_coefficient - low_coefficient)
+        ),
+        0
+    );
+}
+
+void dec64_random_range_n(
+    dec64_random_state state,
+    dec64 low,
+    dec64 high,
+    dec64 results[],
+    int64 length
+) {
+    int64 at;
+
+    for (at = 0; at < length; at += 1) {
+        results[at] = dec64_random_range(state, low, high);
+    }
+}
+
+void dec64_random_reseed(
+    dec64_random_state state,
+    uint64 part_0,
+    uint64 part_1
+) {
+/*
+    Seed a random state object that is in use, such as one made by
+    dec64_random_begin, which must still be passed to dec64_random_end. If the
+    state is not valid, it is not changed.
+*/
+    if (random_valid(state)) {
+        random_seed(state, part_0, part_1);
+    }
+}
+
+dec64 dec64_root(dec64 index, dec64 radicand) {
+/*
+    The root is e**(ln(|radicand|) / index), with the quotient kept in fixed
+    point. An odd root of a negative radicand is negative.
+*/
+    dec64 result;
+
+    index = dec64_normal(index);
+    if (
+        dec64_is_nan(radicand) == DEC64_TRUE
+        || dec64_is_zero(index) == DEC64_TRUE
+        || index < 0
+        || dec64_exponent(index) != 0
+        || (
+            radicand < 0
+            && (dec64_coefficient(index) & 1) == 0
+        )
+    ) {
+        return DEC64_NULL;
+    }
+    if (dec64_is_zero(radicand) == DEC64_TRUE) {
+        return DEC64_ZERO;
+    }
+    if (index == DEC64_ONE) {
+        return radicand;
+    }
+    if (index == DEC64_TWO) {
+        return dec64_sqrt(radicand);
+    }
+    result = exp_fixed(fixed_divide_int(
+        log_fixed(dec64_abs(radicand)),
+        dec64_coefficient(index)
+    ));
+    return (
+        radicand < 0
+        ? dec64_neg(result)
+        : result
+    );
+}
+
+void dec64_seed(uint64 part_0, uint64 part_1) {
+/*
+    Seed the dec64_random function. It takes any 128 bits as the seed value.
+    The seed must contain at least one 1 bit.
+*/
+    dec64_random_init(&random_state, part_0, part_1);
+}
+
+dec64 dec64_sin(dec64 radians) {
+    int64 quadrant;
+    fixed reduced;
+    int64 scale;
+    fixed square;
+
+    if (dec64_is_nan(radians) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(radians)) {
+        return radians;
+    }
+    quadrant = reduce_radians(radians, &reduced, &scale);
+    square = square_scaled(reduced, scale);
+    switch (quadrant) {
+    case 0:
+        return fixed_pack(sine_series(reduced, square), -scale);
+    case 1:
+        return fixed_pack(cosine_series(square), 0);
+    case 2:
+        return fixed_pack(fixed_negate(sine_series(reduced, square)), -scale);
+    default:
+        return fixed_pack(fixed_negate(cosine_series(square)), 0);
+    }
+}
+
+void dec64_sincos(dec64 radians, dec64* sine, dec64* cosine) {
+/*
+    Deliver both the sine and the cosine for the price of one reduction.
+*/
+    fixed cosine_part;
+    int64 quadrant;
+    fixed reduced;
+    int64 scale;
+    fixed sine_part;
+    fixed square;
+
+    if (dec64_is_nan(radians) == DEC64_TRUE) {
+        *sine = DEC64_NULL;
+        *cosine = DEC64_NULL;
+        return;
+    }
+    if (is_tiny(radians)) {
+        *sine = radians;
+        *cosine = DEC64_ONE;
+        return;
+    }
+    quadrant = reduce_radians(radians, &reduced, &scale);
+    square = square_scaled(reduced, scale);
+    sine_part = sine_series(reduced, square);
+    cosine_part = cosine_series(square);
+    if (quadrant >= 2) {
+        sine_part = fixed_negate(sine_part);
+        cosine_part = fixed_negate(cosine_part);
+    }
+    if ((quadrant & 1) == 0) {
+        *sine = fixed_pack(sine_part, -scale);
+        *cosine = fixed_pack(cosine_part, 0);
+    } else {
+        *sine = fixed_pack(cosine_part, 0);
+        *cosine = fixed_pack(fixed_negate(sine_part), -scale);
+    }
+}
+
+dec64 dec64_sqrt(dec64 radicand) {
+/*
+    Scale the coefficient by a power of ten into a 128 bit integer n of 35 or
+    36 digits, leaving an even exponent. The integer square root of n has 18
+    digits. It is estimated with a double, corrected once with the exact
+    difference n - root**2, and then stepped by one until it is the floor.
+    Because the root is the floor, its extra digit rounds it correctly.
+*/
+    int64 coefficient;
+    double correction;
+    int64 exponent;
+    uint64 high;
+    uint64 low;
+    int64 nr_digits;
+    uint64 product_high;
+    uint64 root;
+    int64 scale;
+    uint64 square_high;
+    uint64 square_low;
+
+    if (dec64_is_nan(radicand) == DEC64_TRUE || radicand < 0) {
+        return DEC64_NULL;
+    }
+    coefficient = dec64_coefficient(radicand);
+    if (coefficient == 0) {
+        return DEC64_ZERO;
+    }
+    exponent = dec64_exponent(radicand);
+    nr_digits = count_digits(coefficient);
+    scale = 35 - nr_digits;
+    if (((exponent - scale) & 1) != 0) {
+        scale += 1;
+    }
+    multiply_64(
+        (uint64)coefficient,
+        (uint64)power[
+            scale > 18
+            ? 18
+            : scale
+        ],
+        &high,
+        &low
+    );
+    if (scale > 18) {
+        multiply_64(low, (uint64)power[scale - 18], &product_high, &low);
+        high = high * (uint64)power[scale - 18] + product_high;
+    }
+    exponent = (exponent - scale) / 2;
+
+/*
+    A double has 53 bits, so the estimate is within a few hundred of the root.
+*/
+
+    root = (uint64)sqrt((double)high * 18446744073709551616.0 + (double)low);
+    multiply_64(root, root, &square_high, &square_low);
+    if (square_high > high || (square_high == high && square_low > low)) {
+        correction = -(double)(
+            (square_high - high - (square_low < low)) * 18446744073709551616.0
+            + (double)(square_low - low)
+        );
+    } else {
+        correction = (double)(
+            (high - square_high - (low < square_low)) * 18446744073709551616.0
+            + (double)(low - square_low)
+        );
+    }
+    root = (uint64)((int64)root + (int64)(correction / (2.0 * (double)root)));
+    while (1) {
+        multiply_64(root, root, &square_high, &square_low);
+        if (square_high < high || (square_high == high && square_low <= low)) {
+            break;
+        }
+        root -= 1;
+    }
+    while (1) {
+        multiply_64(root + 1, root + 1, &square_high, &square_low);
+        if (square_high > high || (square_high == high && square_low > low)) {
+            break;
+        }
+        root += 1;
+    }
+    return pack_digits(0, root, exponent);
+}
+
+dec64 dec64_tan(dec64 radians) {
+/*
+    tan = sin / cos, divided in fixed point before rounding. Where the cosine
+    is zero, the result is nan.
+*/
+    fixed cosine_part;
+    int64 quadrant;
+    fixed reduced;
+    int64 scale;
+    fixed sine_part;
+    fixed square;
+
+    if (dec64_is_nan(radians) == DEC64_TRUE) {
+        return DEC64_NULL;
+    }
+    if (is_tiny(radians)) {
+        return radians;
+    }
+    quadrant = reduce_radians(radians, &reduced, &scale);
+    square = square_scaled(reduced, scale);
+    sine_part = sine_series(reduced, square);
+    cosine_part = cosine_series(square);
+    if ((quadrant & 1) == 0) {
+        return fixed_pack(fixed_divide(sine_part, cosine_part), -scale);
+    }
+    if (fixed_is_zero(sine_part)) {
+        return DEC64_NULL;
+    }
+    return fixed_pack(
+        fixed_negate(fixed_divide(cosine_part, sine_part)),
+        scale
     );
 }
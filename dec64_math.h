@@ -9,18 +9,98 @@ Public Domain
 No warranty.
 */
 
+typedef struct dec64_random_state {
+/*
+    For internal use only.
+*/
+    dec64 valid;
+    int allocated;
+    uint64 part_0;
+    uint64 part_1;
+} * dec64_random_state;
+
+/*
+    When dec64_math.c is compiled with DEC64_MATH_COUNT defined, it counts the
+    steps taken by its loops in dec64_math_counts, so that the work a function
+    does can be seen apart from the time it takes.
+*/
+
+#define DEC64_MATH_SERIES   0   /* terms of a polynomial or series */
+#define DEC64_MATH_NEWTON   1   /* correction passes of a divide or a root */
+#define DEC64_MATH_SHIFT    2   /* steps of the argument shift of lgamma */
+#define DEC64_MATH_SQUARE   3   /* steps of the square and multiply of raise */
+#define DEC64_MATH_COUNTS   4
+
+#ifdef DEC64_MATH_COUNT
+extern int64 dec64_math_counts[DEC64_MATH_COUNTS];
+#endif
+
 extern dec64 dec64_acos(dec64 slope);
 extern dec64 dec64_asin(dec64 slope);
 extern dec64 dec64_atan(dec64 slope);
 extern dec64 dec64_atan2(dec64 y, dec64 x);
+extern dec64 dec64_binomial(dec64 n, dec64 k);
 extern dec64 dec64_cos(dec64 radians);
 extern dec64 dec64_exp(dec64 exponent);
 extern dec64 dec64_factorial(dec64 x);
+extern dec64 dec64_gamma(dec64 x);
+extern dec64 dec64_lgamma(dec64 x);
 extern dec64 dec64_log(dec64 x);
+extern dec64 dec64_log10(dec64 x);
+extern dec64 dec64_log2(dec64 x);
+extern dec64 dec64_pow10(dec64 exponent);
 extern dec64 dec64_raise(dec64 coefficient, dec64 exponent);
 extern dec64 dec64_random();
+extern dec64_random_state dec64_random_begin(uint64 part_0, uint64 part_1);
+extern void dec64_random_copy(
+    dec64_random_state destination,
+    dec64_random_state source
+);
+extern void dec64_random_end(dec64_random_state state);
+extern dec64 dec64_random_exponential(dec64_random_state state);
+extern void dec64_random_exponential_n(
+    dec64_random_state state,
+    dec64 results[],
+    int64 length
+);
+extern void dec64_random_init(
+    dec64_random_state state,
+    uint64 part_0,
+    uint64 part_1
+);
+extern void dec64_random_jump(dec64_random_state state);
+extern void dec64_random_n(
+    dec64_random_state state,
+    dec64 results[],
+    int64 length
+);
+extern dec64 dec64_random_next(dec64_random_state state);
+extern dec64 dec64_random_normal(dec64_random_state state);
+extern void dec64_random_normal_n(
+    dec64_random_state state,
+    dec64 results[],
+    int64 length
+);
+extern dec64 dec64_random_range(
+    dec64_random_state state,
+    dec64 low,
+    dec64 high
+);
+extern void dec64_random_range_n(
+    dec64_random_state state,
+    dec64 low,
+    dec64 high,
+    dec64 results[],
+    int64 length
+);
+extern void dec64_random_reseed(
+    dec64_random_state state,
+    uint64 part_0,
+    uint64 part_1
+);
 extern dec64 dec64_root(dec64 index, dec64 radicand);
 extern void  dec64_seed(uint64 part_0, uint64 part_1);
 extern dec64 dec64_sin(dec64 radians);
+extern void dec64_sincos(dec64 radians, dec64* sine, dec64* cosine);
 extern dec64 dec64_sqrt(dec64 radicand);
 extern dec64 dec64_tan(dec64 radians);
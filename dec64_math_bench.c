@@ -0,0 +1,1139 @@
+/* dec64_math_bench.c
+
+This is a benchmark of dec64_math.c. It sweeps each function over ranges of
+arguments, and for each sweep it reports the time per call and the error of
+the results, measured in units in the last place of a dec64. The error is
+taken against a reference that is computed here in a big decimal fixed point
+of 72 fraction digits, which is far more than a dec64 can hold, so that the
+reference can be taken as exact. The reference does not share any code with
+dec64_math.c.
+
+A unit in the last place is the distance between neighboring dec64 values
+near the true result. Below 3.6028797018963967 times a power of ten that is
+a unit in the 17th digit, and above it, a unit in the 16th digit. An error of
+0.5 is the best that rounding can do. A nan where a number was expected is
+counted as an error of 1e99.
+
+The results are written as comma separated values, one line per sweep:
+
+    function,range,calls,ns_per_call,max_ulp,mean_ulp,worst_argument
+
+If dec64_math.c and this file are both compiled with DEC64_MATH_COUNT
+defined, then the steps taken by the loops in dec64_math.c are also counted,
+and four more columns give the average number of series terms, Newton
+passes, lgamma shifts, and raise squarings per call:
+
+    series,newton,shift,square
+
+The number of arguments in a sweep can be given as the first argument.
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dec64.h"
+#include "dec64_math.h"
+
+#define NR_ARGUMENTS 1000
+#define NR_RUNS 5
+#define LIMBS 10
+#define BASE 1000000000LL
+#define HUGE_ERROR 1e99
+
+/*
+    A big is a sign and LIMBS limbs, each holding 9 decimal digits, most
+    significant first. The first 2 limbs hold the integer part, so a big can
+    hold magnitudes less than 1e18, and the other 8 hold 72 digits of
+    fraction. Results are truncated.
+*/
+
+typedef struct big {
+    int negative;
+    int64 limb[LIMBS];
+} big;
+
+static big big_ln10;
+static big big_ln2;
+static big big_half_pi;
+static big big_pi;
+
+static big big_from_int(int64 integer) {
+    big result;
+    uint64 magnitude = (
+        integer < 0
+        ? -(uint64)integer
+        : (uint64)integer
+    );
+
+    memset(&result, 0, sizeof(big));
+    result.negative = integer < 0;
+    result.limb[0] = (int64)(magnitude / BASE);
+    result.limb[1] = (int64)(magnitude % BASE);
+    return result;
+}
+
+static int big_is_zero(big a) {
+    int at;
+
+    for (at = 0; at < LIMBS; at += 1) {
+        if (a.limb[at] != 0) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int magnitude_compare(big a, big b) {
+    int at;
+
+    for (at = 0; at < LIMBS; at += 1) {
+        if (a.limb[at] != b.limb[at]) {
+            return (
+                a.limb[at] < b.limb[at]
+                ? -1
+                : 1
+            );
+        }
+    }
+    return 0;
+}
+
+static big magnitude_add(big a, big b) {
+    int at;
+    int64 carry = 0;
+
+    for (at = LIMBS - 1; at >= 0; at -= 1) {
+        a.limb[at] += b.limb[at] + carry;
+        carry = a.limb[at] >= BASE;
+        if (carry) {
+            a.limb[at] -= BASE;
+        }
+    }
+    return a;
+}
+
+static big magnitude_subtract(big a, big b) {
+/*
+    |a| - |b| where |a| >= |b|.
+*/
+    int at;
+    int64 borrow = 0;
+
+    for (at = LIMBS - 1; at >= 0; at -= 1) {
+        a.limb[at] -= b.limb[at] + borrow;
+        borrow = a.limb[at] < 0;
+        if (borrow) {
+            a.limb[at] += BASE;
+        }
+    }
+    return a;
+}
+
+static big big_fix_sign(big a) {
+    if (big_is_zero(a)) {
+        a.negative = 0;
+    }
+    return a;
+}
+
+static big big_negate(big a) {
+    a.negative = !a.negative;
+    return big_fix_sign(a);
+}
+
+static big big_add(big a, big b) {
+    big result;
+
+    if (a.negative == b.negative) {
+        result = magnitude_add(a, b);
+    } else if (magnitude_compare(a, b) >= 0) {
+        result = magnitude_subtract(a, b);
+    } else {
+        result = magnitude_subtract(b, a);
+    }
+    return big_fix_sign(result);
+}
+
+static big big_subtract(big a, big b) {
+    return big_add(a, big_negate(b));
+}
+
+static big big_multiply(big a, big b) {
+/*
+    A limb of the product at i + j - 1 gets a.limb[i] * b.limb[j]. There are
+    at most LIMBS of those products in a column, so a column can not exceed
+    1e19, which fits in a uint64.
+*/
+    uint64 column[2 * LIMBS];
+    int at;
+    int i;
+    int j;
+    big result;
+
+    memset(column, 0, sizeof(column));
+    for (i = 0; i < LIMBS; i += 1) {
+        for (j = 0; j < LIMBS; j += 1) {
+            column[i + j] += (uint64)a.limb[i] * (uint64)b.limb[j];
+        }
+    }
+    for (at = 2 * LIMBS - 1; at > 0; at -= 1) {
+        column[at - 1] += column[at] / BASE;
+        column[at] %= BASE;
+    }
+    for (at = 0; at < LIMBS; at += 1) {
+        result.limb[at] = (int64)column[at + 1];
+    }
+    result.negative = a.negative != b.negative;
+    return big_fix_sign(result);
+}
+
+static big big_multiply_int(big a, int64 integer) {
+/*
+    The magnitude of the integer must be less than BASE.
+*/
+    int at;
+    int64 carry = 0;
+
+    if (integer < 0) {
+        a.negative = !a.negative;
+        integer = -integer;
+    }
+    for (at = LIMBS - 1; at >= 0; at -= 1) {
+        int64 product = a.limb[at] * integer + carry;
+        a.limb[at] = product % BASE;
+        carry = product / BASE;
+    }
+    return big_fix_sign(a);
+}
+
+static big big_divide_int(big a, int64 divisor) {
+/*
+    The magnitude of the divisor must be less than 9e9.
+*/
+    int at;
+    int64 remainder = 0;
+
+    if (divisor < 0) {
+        a.negative = !a.negative;
+        divisor = -divisor;
+    }
+    for (at = 0; at < LIMBS; at += 1) {
+        int64 dividend = remainder * BASE + a.limb[at];
+        a.limb[at] = dividend / divisor;
+        remainder = dividend % divisor;
+    }
+    return big_fix_sign(a);
+}
+
+static big big_scale(big a, int64 places) {
+/*
+    Multiply by 10**places.
+*/
+    static const int64 tens[9] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+
+    while (places >= 9) {
+        memmove(&a.limb[0], &a.limb[1], sizeof(int64) * (LIMBS - 1));
+        a.limb[LIMBS - 1] = 0;
+        places -= 9;
+    }
+    while (places <= -9) {
+        memmove(&a.limb[1], &a.limb[0], sizeof(int64) * (LIMBS - 1));
+        a.limb[0] = 0;
+        places += 9;
+    }
+    return (
+        places >= 0
+        ? big_multiply_int(a, tens[places])
+        : big_divide_int(a, tens[-places])
+    );
+}
+
+static big big_from_dec64(dec64 number) {
+    return big_scale(
+        big_from_int(dec64_coefficient(number)),
+        dec64_exponent(number)
+    );
+}
+
+static double big_to_double(big a) {
+    int at;
+    double result = 0;
+    double unit = 1e9;
+
+    for (at = 0; at < LIMBS; at += 1) {
+        result += (double)a.limb[at] * unit;
+        unit /= 1e9;
+    }
+    return (
+        a.negative
+        ? -result
+        : result
+    );
+}
+
+static big big_from_double(double number) {
+    int at;
+    big result;
+    double x = fabs(number);
+
+    result.negative = number < 0;
+    result.limb[0] = (int64)floor(x / 1e9);
+    x -= (double)result.limb[0] * 1e9;
+    for (at = 1; at < LIMBS; at += 1) {
+        result.limb[at] = (int64)floor(x);
+        x = (x - (double)result.limb[at]) * 1e9;
+    }
+    return big_fix_sign(result);
+}
+
+static big big_normalize(big a, int64* power) {
+/*
+    Scale a nonzero big to 1 <= |a| < 10, and add the power of ten that was
+    taken out to power.
+*/
+    int at;
+    int64 digits;
+    int64 limb;
+
+    for (at = 0; at < LIMBS - 1 && a.limb[at] == 0; at += 1) {
+    }
+    digits = 0;
+    for (limb = a.limb[at]; limb >= 10; limb /= 10) {
+        digits += 1;
+    }
+    digits += (1 - at) * 9;
+    *power += digits;
+    return big_scale(a, -digits);
+}
+
+static big big_divide(big a, big b) {
+/*
+    Take the reciprocal of b by Newton's method from a double estimate, and
+    correct the quotient once.
+*/
+    int pass;
+    big quotient;
+    big reciprocal = big_from_double(1.0 / big_to_double(b));
+    big two = big_from_int(2);
+
+    for (pass = 0; pass < 4; pass += 1) {
+        reciprocal = big_multiply(
+            reciprocal,
+            big_subtract(two, big_multiply(b, reciprocal))
+        );
+    }
+    quotient = big_multiply(a, reciprocal);
+    return big_add(
+        quotient,
+        big_multiply(
+            big_subtract(a, big_multiply(quotient, b)),
+            reciprocal
+        )
+    );
+}
+
+static big big_sqrt(big a) {
+    int pass;
+    big root = big_from_double(sqrt(big_to_double(a)));
+
+    for (pass = 0; pass < 5; pass += 1) {
+        root = big_divide_int(big_add(root, big_divide(a, root)), 2);
+    }
+    return root;
+}
+
+static big series_exp(big x) {
+/*
+    e**x by Taylor's series, for small x.
+*/
+    int64 n;
+    big sum = big_from_int(1);
+    big term = sum;
+
+    for (n = 1; n < 400 && !big_is_zero(term); n += 1) {
+        term = big_divide_int(big_multiply(term, x), n);
+        sum = big_add(sum, term);
+    }
+    return sum;
+}
+
+static big series_sin(big x) {
+    int64 n;
+    big square = big_multiply(x, x);
+    big sum = x;
+    big term = x;
+
+    for (n = 2; n < 400 && !big_is_zero(term); n += 2) {
+        term = big_negate(big_divide_int(big_multiply(term, square), n * (n + 1)));
+        sum = big_add(sum, term);
+    }
+    return sum;
+}
+
+static big series_cos(big x) {
+    int64 n;
+    big square = big_multiply(x, x);
+    big sum = big_from_int(1);
+    big term = sum;
+
+    for (n = 1; n < 400 && !big_is_zero(term); n += 2) {
+        term = big_negate(big_divide_int(big_multiply(term, square), n * (n + 1)));
+        sum = big_add(sum, term);
+    }
+    return sum;
+}
+
+static big series_atan(big x) {
+/*
+    atan(x) for small x.
+*/
+    int64 n;
+    big square = big_multiply(x, x);
+    big sum = x;
+    big power = x;
+
+    for (n = 3; n < 1000 && !big_is_zero(power); n += 2) {
+        power = big_negate(big_multiply(power, square));
+        sum = big_add(sum, big_divide_int(power, n));
+    }
+    return sum;
+}
+
+static big series_inverse(int64 n, int alternate) {
+/*
+    atan(1/n), or atanh(1/n) if not alternate.
+*/
+    int64 k;
+    big power = big_divide_int(big_from_int(1), n);
+    big sum = power;
+
+    for (k = 3; !big_is_zero(power); k += 2) {
+        power = big_divide_int(power, n * n);
+        if (alternate) {
+            power = big_negate(power);
+        }
+        sum = big_add(sum, big_divide_int(power, k));
+    }
+    return sum;
+}
+
+static void define_constants() {
+/*
+    pi = 16 atan(1/5) - 4 atan(1/239)
+    ln(2) = 2 atanh(1/3)
+    ln(10) = 3 ln(2) + ln(1.25) = 3 ln(2) + 2 atanh(1/9)
+*/
+    big_pi = big_subtract(
+        big_multiply_int(series_inverse(5, 1), 16),
+        big_multiply_int(series_inverse(239, 1), 4)
+    );
+    big_half_pi = big_divide_int(big_pi, 2);
+    big_ln2 = big_multiply_int(series_inverse(3, 0), 2);
+    big_ln10 = big_add(
+        big_multiply_int(big_ln2, 3),
+        big_multiply_int(series_inverse(9, 0), 2)
+    );
+}
+
+/* the reference functions */
+
+static big big_exp(big x, int64* power) {
+/*
+    e**x = e**r * 10**k, where r = x - k ln(10).
+*/
+    int64 k = (int64)floor(big_to_double(x) / big_to_double(big_ln10));
+
+    *power += k;
+    return series_exp(big_subtract(x, big_multiply_int(big_ln10, k)));
+}
+
+static big big_log(big x) {
+/*
+    ln(x) for x > 0. x = m * 10**k with 1 <= m < 10, and ln(m) is found by
+    Halley's method on e**z - m, which triples the digits with each pass.
+*/
+    int64 k = 0;
+    big m = big_normalize(x, &k);
+    int pass;
+    big z = big_from_double(log(big_to_double(m)));
+
+    for (pass = 0; pass < 3; pass += 1) {
+        big power = series_exp(z);
+        z = big_add(
+            z,
+            big_multiply_int(
+                big_divide(big_subtract(m, power), big_add(m, power)),
+                2
+            )
+        );
+    }
+    return big_add(z, big_multiply_int(big_ln10, k));
+}
+
+static big log_dec64(dec64 x) {
+/*
+    ln(x) for a dec64 of any exponent.
+*/
+    return big_add(
+        big_log(big_from_int(dec64_coefficient(x))),
+        big_multiply_int(big_ln10, dec64_exponent(x))
+    );
+}
+
+static big big_sin_quadrant(big x, int64 shift) {
+/*
+    sin(x + shift * pi/2).
+*/
+    int64 k = (int64)floor(
+        big_to_double(x) / big_to_double(big_half_pi) + 0.5
+    );
+    big r = big_subtract(x, big_multiply_int(big_half_pi, k));
+
+    switch ((k + shift) & 3) {
+    case 0:
+        return series_sin(r);
+    case 1:
+        return series_cos(r);
+    case 2:
+        return big_negate(series_sin(r));
+    default:
+        return big_negate(series_cos(r));
+    }
+}
+
+static big big_atan(big x) {
+/*
+    Turn x over if it is more than 1, and then halve the angle twice with
+
+        atan(x) = 2 atan(x / (1 + sqrt(1 + x**2)))
+
+    so that the series converges quickly.
+*/
+    big one = big_from_int(1);
+    big result;
+
+    if (x.negative) {
+        return big_negate(big_atan(big_negate(x)));
+    }
+    if (magnitude_compare(x, one) > 0) {
+        return big_subtract(big_half_pi, big_atan(big_divide(one, x)));
+    }
+    x = big_divide(x, big_add(one, big_sqrt(big_add(one, big_multiply(x, x)))));
+    x = big_divide(x, big_add(one, big_sqrt(big_add(one, big_multiply(x, x)))));
+    result = big_multiply_int(series_atan(x), 4);
+    return result;
+}
+
+static big big_asin(big x) {
+    big one = big_from_int(1);
+    big cosine = big_subtract(one, big_multiply(x, x));
+
+    if (big_is_zero(cosine)) {
+        return (
+            x.negative
+            ? big_negate(big_half_pi)
+            : big_half_pi
+        );
+    }
+    return big_atan(big_divide(x, big_sqrt(cosine)));
+}
+
+static big big_lgamma(big x) {
+/*
+    ln(gamma(x)) for x > 0. x is shifted up to at least 40, and then
+    Stirling's series is used to the B28 term, which is good to 40 digits.
+*/
+    static const int64 numerators[14] = {
+        1, -1, 1, -1, 5, -691, 7, -3617, 43867, -174611, 854513, -236364091,
+        8553103, -23749461029
+    };
+    static const int64 denominators[14] = {
+        6, 30, 42, 30, 66, 2730, 6, 510, 798, 330, 138, 2730, 6, 870
+    };
+    int64 k;
+    big logs;
+    big product = big_from_int(1);
+    big reciprocal;
+    big power;
+    big square;
+    big sum;
+    big ten_thousand = big_from_int(10000);
+
+    memset(&logs, 0, sizeof(big));
+    while (big_to_double(x) < 40) {
+        product = big_multiply(product, x);
+        if (magnitude_compare(product, ten_thousand) > 0) {
+            logs = big_add(logs, big_log(product));
+            product = big_from_int(1);
+        }
+        x = big_add(x, big_from_int(1));
+    }
+    logs = big_add(logs, big_log(product));
+    reciprocal = big_divide(big_from_int(1), x);
+    square = big_multiply(reciprocal, reciprocal);
+    power = reciprocal;
+    sum = big_subtract(
+        big_multiply(
+            big_subtract(x, big_divide_int(big_from_int(1), 2)),
+            big_log(x)
+        ),
+        x
+    );
+    sum = big_add(sum, big_divide_int(big_log(big_multiply_int(big_pi, 2)), 2));
+    for (k = 1; k <= 14; k += 1) {
+        sum = big_add(
+            sum,
+            big_divide_int(
+                big_multiply(big_from_int(numerators[k - 1]), power),
+                denominators[k - 1] * (2 * k) * (2 * k - 1)
+            )
+        );
+        power = big_multiply(power, square);
+    }
+    return big_subtract(sum, logs);
+}
+
+static big big_gamma(big x, int64* power) {
+/*
+    For x < 0, gamma(x) = pi / (sin(pi x) gamma(1 - x)).
+*/
+    big one = big_from_int(1);
+    big result;
+    big sine;
+
+    if (!x.negative) {
+        return big_exp(big_lgamma(x), power);
+    }
+    sine = big_sin_quadrant(big_multiply(big_pi, x), 0);
+    result = big_exp(
+        big_subtract(
+            big_log(big_pi),
+            big_add(
+                big_log(sine.negative ? big_negate(sine) : sine),
+                big_lgamma(big_subtract(one, x))
+            )
+        ),
+        power
+    );
+    return (
+        sine.negative
+        ? big_negate(result)
+        : result
+    );
+}
+
+static big reference_acos(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_subtract(big_half_pi, big_asin(big_from_dec64(x)));
+}
+
+static big reference_asin(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_asin(big_from_dec64(x));
+}
+
+static big reference_atan(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_atan(big_from_dec64(x));
+}
+
+static big reference_atan2(dec64 y, dec64 x, int64* power) {
+    big angle;
+    big big_x = big_from_dec64(x);
+    big big_y = big_from_dec64(y);
+
+    (void)power;
+    angle = (
+        big_is_zero(big_x)
+        ? big_half_pi
+        : big_atan(big_divide(
+            big_y.negative ? big_negate(big_y) : big_y,
+            big_x.negative ? big_negate(big_x) : big_x
+        ))
+    );
+    if (big_x.negative) {
+        angle = big_subtract(big_pi, angle);
+    }
+    return (
+        big_y.negative
+        ? big_negate(angle)
+        : angle
+    );
+}
+
+static big reference_cos(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_sin_quadrant(big_from_dec64(x), 1);
+}
+
+static big reference_exp(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    return big_exp(big_from_dec64(x), power);
+}
+
+static big reference_factorial(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    return big_gamma(big_add(big_from_dec64(x), big_from_int(1)), power);
+}
+
+static big reference_gamma(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    return big_gamma(big_from_dec64(x), power);
+}
+
+static big reference_lgamma(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_lgamma(big_from_dec64(x));
+}
+
+static big reference_log(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return log_dec64(x);
+}
+
+static big reference_log10(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_divide(log_dec64(x), big_ln10);
+}
+
+static big reference_log2(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_divide(log_dec64(x), big_ln2);
+}
+
+static big reference_pow10(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    return big_exp(big_multiply(big_from_dec64(x), big_ln10), power);
+}
+
+static big reference_raise(dec64 x, dec64 y, int64* power) {
+    return big_exp(big_multiply(big_from_dec64(y), log_dec64(x)), power);
+}
+
+static big reference_root(dec64 degree, dec64 x, int64* power) {
+    return big_exp(
+        big_divide_int(log_dec64(x), dec64_coefficient(degree)),
+        power
+    );
+}
+
+static big reference_sin(dec64 x, dec64 y, int64* power) {
+    (void)y;
+    (void)power;
+    return big_sin_quadrant(big_from_dec64(x), 0);
+}
+
+static big reference_sqrt(dec64 x, dec64 y, int64* power) {
+/*
+    sqrt(c * 10**e) = sqrt(c) * 10**(e/2), after making e even.
+*/
+    int64 coefficient = dec64_coefficient(x);
+    int64 exponent = dec64_exponent(x);
+
+    (void)y;
+    if ((exponent & 1) != 0) {
+        coefficient *= 10;
+        exponent -= 1;
+    }
+    *power += exponent / 2;
+    return big_sqrt(big_from_int(coefficient));
+}
+
+static big reference_tan(dec64 x, dec64 y, int64* power) {
+    big big_x = big_from_dec64(x);
+
+    (void)y;
+    (void)power;
+    return big_divide(big_sin_quadrant(big_x, 0), big_sin_quadrant(big_x, 1));
+}
+
+/* the sweeps */
+
+typedef dec64 (*unary)(dec64);
+typedef dec64 (*binary)(dec64, dec64);
+typedef big (*reference)(dec64, dec64, int64*);
+
+#define CONSTANT    0
+#define LINEAR      1
+#define LOGARITHMIC 2
+#define NONE        3
+
+struct sweep {
+    char* name;
+    char* range;
+    unary unary_function;
+    binary binary_function;
+    reference reference_function;
+    int first_kind;
+    double first_low;
+    double first_high;
+    int second_kind;
+    double second_low;
+    double second_high;
+};
+
+/*
+    A LINEAR argument is uniform between low and high. A LOGARITHMIC argument
+    is 10 raised to a power that is uniform between low and high. A CONSTANT
+    argument is low. A unary function has NONE for its second argument.
+*/
+
+static struct sweep sweeps[] = {
+    {
+        "acos", "-1..1", dec64_acos, NULL, reference_acos,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "asin", "-1..1", dec64_asin, NULL, reference_asin,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "atan", "-1..1", dec64_atan, NULL, reference_atan,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "atan", "1e-10..1e10", dec64_atan, NULL, reference_atan,
+        LOGARITHMIC, -10, 10, NONE, 0, 0
+    },
+    {
+        "atan2", "-10..10", NULL, dec64_atan2, reference_atan2,
+        LINEAR, -10, 10, LINEAR, -10, 10
+    },
+    {
+        "cos", "-1..1", dec64_cos, NULL, reference_cos,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "cos", "-100..100", dec64_cos, NULL, reference_cos,
+        LINEAR, -100, 100, NONE, 0, 0
+    },
+    {
+        "cos", "-1e6..1e6", dec64_cos, NULL, reference_cos,
+        LINEAR, -1e6, 1e6, NONE, 0, 0
+    },
+    {
+        "exp", "-1..1", dec64_exp, NULL, reference_exp,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "exp", "-50..50", dec64_exp, NULL, reference_exp,
+        LINEAR, -50, 50, NONE, 0, 0
+    },
+    {
+        "exp", "-250..250", dec64_exp, NULL, reference_exp,
+        LINEAR, -250, 250, NONE, 0, 0
+    },
+    {
+        "factorial", "0..80", dec64_factorial, NULL, reference_factorial,
+        LINEAR, 0, 80, NONE, 0, 0
+    },
+    {
+        "gamma", "0.1..80", dec64_gamma, NULL, reference_gamma,
+        LINEAR, 0.1, 80, NONE, 0, 0
+    },
+    {
+        "gamma", "-20..-0.1", dec64_gamma, NULL, reference_gamma,
+        LINEAR, -20, -0.1, NONE, 0, 0
+    },
+    {
+        "lgamma", "0.1..40", dec64_lgamma, NULL, reference_lgamma,
+        LINEAR, 0.1, 40, NONE, 0, 0
+    },
+    {
+        "lgamma", "40..1e6", dec64_lgamma, NULL, reference_lgamma,
+        LOGARITHMIC, 1.6, 6, NONE, 0, 0
+    },
+    {
+        "log", "0.5..2", dec64_log, NULL, reference_log,
+        LINEAR, 0.5, 2, NONE, 0, 0
+    },
+    {
+        "log", "1e-100..1e100", dec64_log, NULL, reference_log,
+        LOGARITHMIC, -100, 100, NONE, 0, 0
+    },
+    {
+        "log10", "1e-50..1e50", dec64_log10, NULL, reference_log10,
+        LOGARITHMIC, -50, 50, NONE, 0, 0
+    },
+    {
+        "log2", "1e-50..1e50", dec64_log2, NULL, reference_log2,
+        LOGARITHMIC, -50, 50, NONE, 0, 0
+    },
+    {
+        "pow10", "-100..100", dec64_pow10, NULL, reference_pow10,
+        LINEAR, -100, 100, NONE, 0, 0
+    },
+    {
+        "raise", "1e-3..1e3 ** -10..10", NULL, dec64_raise, reference_raise,
+        LOGARITHMIC, -3, 3, LINEAR, -10, 10
+    },
+    {
+        "root", "3 root 1e-50..1e50", NULL, dec64_root, reference_root,
+        CONSTANT, 3, 3, LOGARITHMIC, -50, 50
+    },
+    {
+        "sin", "-1..1", dec64_sin, NULL, reference_sin,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "sin", "-100..100", dec64_sin, NULL, reference_sin,
+        LINEAR, -100, 100, NONE, 0, 0
+    },
+    {
+        "sin", "-1e6..1e6", dec64_sin, NULL, reference_sin,
+        LINEAR, -1e6, 1e6, NONE, 0, 0
+    },
+    {
+        "sqrt", "1e-100..1e100", dec64_sqrt, NULL, reference_sqrt,
+        LOGARITHMIC, -100, 100, NONE, 0, 0
+    },
+    {
+        "tan", "-1..1", dec64_tan, NULL, reference_tan,
+        LINEAR, -1, 1, NONE, 0, 0
+    },
+    {
+        "tan", "-100..100", dec64_tan, NULL, reference_tan,
+        LINEAR, -100, 100, NONE, 0, 0
+    }
+};
+
+static uint64 seed = 0x0123456789ABCDEF;
+static volatile dec64 sink;
+
+static double uniform() {
+/*
+    A small xorshift generator, so that the arguments are the same on every
+    run and do not depend on dec64_math.c.
+*/
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return (double)(seed >> 11) / 9007199254740992.0;
+}
+
+static dec64 make_argument(int kind, double low, double high) {
+/*
+    Make an argument with 16 significant digits.
+*/
+    double x;
+    int64 exponent;
+
+    if (kind == CONSTANT) {
+        return dec64_new((int64)low, 0);
+    }
+    x = low + (high - low) * uniform();
+    if (kind == LOGARITHMIC) {
+        x = pow(10, x);
+    }
+    if (x == 0) {
+        return DEC64_ZERO;
+    }
+    exponent = (int64)floor(log10(fabs(x))) - 15;
+    return dec64_new((int64)floor(x / pow(10, (double)exponent) + 0.5), exponent);
+}
+
+static double ulp_error(dec64 result, big expected, int64 power) {
+/*
+    The distance from the result to the expected value * 10**power, in units
+    in the last place.
+*/
+    int64 at;
+    int64 digits;
+    int64 coefficient;
+    big difference;
+
+    if (big_is_zero(expected)) {
+        return (
+            dec64_is_zero(result) == DEC64_TRUE
+            ? 0
+            : HUGE_ERROR
+        );
+    }
+    if (dec64_is_nan(result) == DEC64_TRUE) {
+        return HUGE_ERROR;
+    }
+    expected = big_normalize(expected, &power);
+
+/*
+    A result that is not within a factor of 10 can not be placed beside the
+    expected value.
+*/
+
+    coefficient = dec64_coefficient(result);
+    digits = 0;
+    for (at = coefficient < 0 ? -coefficient : coefficient; at >= 10; at /= 10) {
+        digits += 1;
+    }
+    digits += dec64_exponent(result) - power;
+    if (digits < -1 || digits > 1) {
+        return HUGE_ERROR;
+    }
+    difference = big_subtract(
+        big_scale(big_from_int(coefficient), dec64_exponent(result) - power),
+        expected
+    );
+    return fabs(big_to_double(difference)) * (
+        fabs(big_to_double(expected)) < 3.6028797018963967
+        ? 1e16
+        : 1e15
+    );
+}
+
+static double now() {
+/*
+    The time in nanoseconds.
+*/
+    struct timespec time;
+
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+static void print_dec64(dec64 number) {
+    printf("%llde%lld", dec64_coefficient(number), dec64_exponent(number));
+}
+
+static void run_sweep(struct sweep* s, int64 nr_arguments) {
+    int64 at;
+    dec64* firsts = (dec64*)malloc(sizeof(dec64) * nr_arguments);
+    dec64* seconds = (dec64*)malloc(sizeof(dec64) * nr_arguments);
+    dec64* results = (dec64*)malloc(sizeof(dec64) * nr_arguments);
+    double runs[NR_RUNS];
+    int run_nr;
+    double max_error = -1;
+    double sum_error = 0;
+    int64 worst = 0;
+#ifdef DEC64_MATH_COUNT
+    int kind;
+    int64 counts[DEC64_MATH_COUNTS];
+#endif
+
+    if (firsts == NULL || seconds == NULL || results == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    for (at = 0; at < nr_arguments; at += 1) {
+        firsts[at] = make_argument(s->first_kind, s->first_low, s->first_high);
+        seconds[at] = (
+            s->binary_function != NULL
+            ? make_argument(s->second_kind, s->second_low, s->second_high)
+            : DEC64_ZERO
+        );
+    }
+
+/*
+    Time the function over all of the arguments, taking the median of the
+    runs.
+*/
+
+#ifdef DEC64_MATH_COUNT
+    memset(dec64_math_counts, 0, sizeof(dec64_math_counts));
+#endif
+    for (run_nr = 0; run_nr < NR_RUNS; run_nr += 1) {
+        double start = now();
+        if (s->unary_function != NULL) {
+            for (at = 0; at < nr_arguments; at += 1) {
+                results[at] = s->unary_function(firsts[at]);
+            }
+        } else {
+            for (at = 0; at < nr_arguments; at += 1) {
+                results[at] = s->binary_function(firsts[at], seconds[at]);
+            }
+        }
+        runs[run_nr] = (now() - start) / (double)nr_arguments;
+    }
+#ifdef DEC64_MATH_COUNT
+    memcpy(counts, dec64_math_counts, sizeof(counts));
+#endif
+    qsort(runs, NR_RUNS, sizeof(double), compare_doubles);
+    sink = results[0];
+
+/*
+    Measure the error of each result.
+*/
+
+    for (at = 0; at < nr_arguments; at += 1) {
+        int64 power = 0;
+        big expected = s->reference_function(firsts[at], seconds[at], &power);
+        double error = ulp_error(results[at], expected, power);
+        sum_error += error;
+        if (error > max_error) {
+            max_error = error;
+            worst = at;
+        }
+    }
+    printf(
+        "%s,%s,%lld,%.1f,%.3g,%.3g,",
+        s->name,
+        s->range,
+        nr_arguments,
+        runs[NR_RUNS / 2],
+        max_error,
+        sum_error / (double)nr_arguments
+    );
+    if (s->binary_function != NULL) {
+        print_dec64(firsts[worst]);
+        printf(" ");
+        print_dec64(seconds[worst]);
+    } else {
+        print_dec64(firsts[worst]);
+    }
+#ifdef DEC64_MATH_COUNT
+    for (kind = 0; kind < DEC64_MATH_COUNTS; kind += 1) {
+        printf(
+            ",%.1f",
+            (double)counts[kind] / (double)(nr_arguments * NR_RUNS)
+        );
+    }
+#endif
+    printf("\n");
+    free(firsts);
+    free(seconds);
+    free(results);
+}
+
+int main(int argc, char* argv[]) {
+    int64 nr_arguments = NR_ARGUMENTS;
+    size_t sweep_nr;
+
+    if (argc > 1) {
+        nr_arguments = atoll(argv[1]);
+        if (nr_arguments <= 0) {
+            nr_arguments = NR_ARGUMENTS;
+        }
+    }
+    define_constants();
+#ifdef DEC64_MATH_COUNT
+    printf("function,range,calls,ns_per_call,max_ulp,mean_ulp,worst_argument,series,newton,shift,square\n");
+#else
+    printf("function,range,calls,ns_per_call,max_ulp,mean_ulp,worst_argument\n");
+#endif
+    for (sweep_nr = 0; sweep_nr < sizeof(sweeps) / sizeof(sweeps[0]); sweep_nr += 1) {
+        run_sweep(&sweeps[sweep_nr], nr_arguments);
+    }
+    return 0;
+}
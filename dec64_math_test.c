@@ -216,6 +216,16 @@ static void test_atan(dec64 first, dec64 expected, char * comment) {
     judge_unary(first, expected, actual, "atan", "at", comment);
 }
 
+static void test_atan2(dec64 first, dec64 second, dec64 expected, char * comment) {
+    dec64 actual = dec64_atan2(first, second);
+    judge_binary(first, second, expected, actual, "atan2", "a", comment);
+}
+
+static void test_binomial(dec64 first, dec64 second, dec64 expected, char * comment) {
+    dec64 actual = dec64_binomial(first, second);
+    judge_binary(first, second, expected, actual, "binomial", "C", comment);
+}
+
 static void test_cos(dec64 first, dec64 expected, char * comment) {
     dec64 actual = dec64_cos(first);
     judge_unary(first, expected, actual, "cos", "c", comment);
@@ -231,11 +241,36 @@ static void test_factorial(dec64 first, dec64 expected, char * comment) {
     judge_unary(first, expected, actual, "fac", "!", comment);
 }
 
+static void test_gamma(dec64 first, dec64 expected, char * comment) {
+    dec64 actual = dec64_gamma(first);
+    judge_unary(first, expected, actual, "gamma", "G", comment);
+}
+
+static void test_lgamma(dec64 first, dec64 expected, char * comment) {
+    dec64 actual = dec64_lgamma(first);
+    judge_unary(first, expected, actual, "lgamma", "lG", comment);
+}
+
 static void test_log(dec64 first, dec64 expected, char * comment) {
     dec64 actual = dec64_log(first);
     judge_unary(first, expected, actual, "log", "ln", comment);
 }
 
+static void test_log10(dec64 first, dec64 expected, char * comment) {
+    dec64 actual = dec64_log10(first);
+    judge_unary(first, expected, actual, "log10", "lg", comment);
+}
+
+static void test_log2(dec64 first, dec64 expected, char * comment) {
+    dec64 actual = dec64_log2(first);
+    judge_unary(first, expected, actual, "log2", "lb", comment);
+}
+
+static void test_pow10(dec64 first, dec64 expected, char * comment) {
+    dec64 actual = dec64_pow10(first);
+    judge_unary(first, expected, actual, "pow10", "p", comment);
+}
+
 static void test_raise(dec64 first, dec64 second, dec64 expected, char * comment) {
     dec64 actual = dec64_raise(first, second);
     judge_binary(first, second, expected, actual, "raise", "^", comment);
@@ -251,6 +286,19 @@ static void test_sin(dec64 first, dec64 expected, char * comment) {
     judge_unary(first, expected, actual, "sin", "s", comment);
 }
 
+static void test_sincos(
+    dec64 first,
+    dec64 expected_sine,
+    dec64 expected_cosine,
+    char * comment
+) {
+    dec64 sine;
+    dec64 cosine;
+    dec64_sincos(first, &sine, &cosine);
+    judge_unary(first, expected_sine, sine, "sincos", "s", comment);
+    judge_unary(first, expected_cosine, cosine, "sincos", "c", comment);
+}
+
 static void test_sqrt(dec64 first, dec64 expected, char * comment) {
     dec64 actual = dec64_sqrt(first);
     judge_unary(first, expected, actual, "sqrt", "s", comment);
@@ -269,6 +317,9 @@ static void test_all_acos() {
     test_acos(half, dec64_new(10471975511965977, -16), "0.5");
     test_acos(one, zero, "1");
     test_acos(half_pi, nan, "pi/2");
+    test_acos(dec64_new(-5, -1), dec64_new(20943951023931955, -16), "-0.5");
+    test_acos(dec64_new(9999999999999999, -16), dec64_new(14142135623730951, -24), "0.9999999999999999");
+    test_acos(nan, nan, "nan");
 }
 
 static void test_all_asin() {
@@ -279,6 +330,8 @@ static void test_all_asin() {
     test_asin(half, dec64_new(5235987755982989, -16), "0.5");
     test_asin(one, half_pi, "1");
     test_asin(half_pi, nan, "pi/2");
+    test_asin(dec64_new(9999999999999999, -16), dec64_new(1570796312652761, -15), "0.9999999999999999");
+    test_asin(nan, nan, "nan");
 }
 
 static void test_all_atan() {
@@ -291,6 +344,41 @@ static void test_all_atan() {
     test_atan(e, dec64_new(12182829050172776, -16), "e");
     test_atan(pi, dec64_new(12626272556789117, -16), "pi");
     test_atan(ten, dec64_new(14711276743037346, -16), "10");
+    test_atan(dec64_new(1, 50), dec64_new(15707963267948966, -16), "1e50");
+    test_atan(dec64_new(-1, -20), dec64_new(-1, -20), "-1e-20");
+    test_atan(nan, nan, "nan");
+}
+
+static void test_all_atan2() {
+    test_atan2(zero, zero, nan, "0, 0");
+    test_atan2(zero, negative_one, pi, "0, -1");
+    test_atan2(one, zero, half_pi, "1, 0");
+    test_atan2(negative_one, zero, dec64_neg(half_pi), "-1, 0");
+    test_atan2(one, one, dec64_new(7853981633974483, -16), "1, 1");
+    test_atan2(one, negative_one, dec64_new(23561944901923449, -16), "1, -1");
+    test_atan2(negative_one, negative_one, dec64_new(-23561944901923449, -16), "-1, -1");
+    test_atan2(dec64_new(1, -50), one, dec64_new(1, -50), "1e-50, 1");
+    test_atan2(nan, one, nan, "nan, 1");
+}
+
+static void test_all_binomial() {
+    test_binomial(five, two, ten, "5 2");
+    test_binomial(five, zero, one, "5 0");
+    test_binomial(five, five, one, "5 5");
+    test_binomial(five, six, zero, "5 6");
+    test_binomial(zero, zero, one, "0 0");
+    test_binomial(ten, five, dec64_new(252, 0), "10 5");
+    test_binomial(dec64_new(52, 0), five, dec64_new(2598960, 0), "52 5");
+    test_binomial(dec64_new(62, 0), dec64_new(28, 0), dec64_new(34961571655788747, 1), "62 28");
+    test_binomial(hundred, dec64_new(50, 0), dec64_new(10089134454556419, 13), "100 50");
+    test_binomial(dec64_new(200, 0), hundred, dec64_new(9054851465610328, 43), "200 100");
+    test_binomial(dec64_new(1000, 0), three, dec64_new(166167000, 0), "1000 3");
+    test_binomial(dec64_new(1000, 0), dec64_new(500, 0), nan, "1000 500");
+    test_binomial(maxint, two, dec64_new(6490371073168534, 17), "maxint 2");
+    test_binomial(five, negative_one, nan, "5 -1");
+    test_binomial(negative_one, zero, nan, "-1 0");
+    test_binomial(half, zero, nan, "1/2 0");
+    test_binomial(nan, one, nan, "nan 1");
 }
 
 static void test_all_cos() {
@@ -299,6 +387,10 @@ static void test_all_cos() {
     test_cos(pi, negative_one, "pi");
     test_cos(half_pi, zero, "pi");
     test_cos(ten, dec64_new(-8390715290764525, -16), "10");
+    test_cos(dec64_new(1, -9), one, "1e-9");
+    test_cos(dec64_new(32768, 0), dec64_new(372937829327715, -15), "32768");
+    test_cos(dec64_new(1, 22), dec64_new(5232147853951389, -16), "1e22");
+    test_cos(nan, nan, "nan");
 }
 
 static void test_all_exp() {
@@ -308,6 +400,18 @@ static void test_all_exp() {
     test_exp(one, e, "1");
     test_exp(two,  dec64_new(7389056098930650, -15), "2");
     test_exp(ten,  dec64_new(22026465794806717, -12), "10");
+    test_exp(negative_one, dec64_new(3678794411714423, -16), "-1");
+    test_exp(dec64_new(-1, -2), dec64_new(9900498337491681, -16), "-0.01");
+    test_exp(dec64_new(1, -10), dec64_new(10000000001, -10), "1e-10");
+    test_exp(dec64_new(-6931471805599453, -16), half, "-ln 2");
+    test_exp(hundred, dec64_new(26881171418161354, 27), "100");
+    test_exp(dec64_neg(hundred), dec64_new(3720075976020836, -59), "-100");
+    test_exp(dec64_new(33, 1), dec64_new(2075769029922787, 128), "330");
+    test_exp(dec64_new(331, 0), nan, "331");
+    test_exp(dec64_new(-292, 0), dec64_new(2, -127), "-292");
+    test_exp(dec64_new(-1, 3), zero, "-1000");
+    test_exp(maxnum, nan, "maxnum");
+    test_exp(nan, nan, "nan");
 }
 
 static void test_all_factorial() {
@@ -321,13 +425,63 @@ static void test_all_factorial() {
     test_factorial(dec64_new(92, 0), dec64_new(12438414054641307, 126), "92!");
     test_factorial(dec64_new(93, 0), nan, "93!");
     test_factorial(nan, nan, "nan!");
-    test_factorial(pi, nan, "pi!");
+    test_factorial(pi, dec64_new(7188082728976032, -15), "pi!");
     test_factorial(negative_one, nan, "-1!");
+    test_factorial(half, dec64_new(886226925452758, -15), "1/2!");
+    test_factorial(dec64_neg(half), dec64_new(1772453850905516, -15), "-1/2!");
+    test_factorial(dec64_new(-15, -1), dec64_new(-35449077018110321, -16), "-3/2!");
+    test_factorial(dec64_new(105, -1), dec64_new(11899423083962248, -9), "10.5!");
+    test_factorial(dec64_new(1, 20), nan, "1e20!");
+}
+
+static void test_all_gamma() {
+    test_gamma(nan, nan, "nan");
+    test_gamma(zero, nan, "0");
+    test_gamma(negative_one, nan, "-1");
+    test_gamma(dec64_new(-2, 3), nan, "-2000");
+    test_gamma(one, one, "1");
+    test_gamma(five, dec64_new(24, 0), "5");
+    test_gamma(half, dec64_new(1772453850905516, -15), "1/2");
+    test_gamma(dec64_neg(half), dec64_new(-35449077018110321, -16), "-1/2");
+    test_gamma(dec64_new(15, -1), dec64_new(886226925452758, -15), "3/2");
+    test_gamma(dec64_new(55, -1), dec64_new(5234277778455352, -14), "5.5");
+    test_gamma(dec64_new(-25, -1), dec64_new(-9453087204829419, -16), "-2.5");
+    test_gamma(dec64_new(1, -1), dec64_new(9513507698668732, -15), "0.1");
+    test_gamma(dec64_new(1, -3), dec64_new(9994237724845955, -13), "0.001");
+    test_gamma(dec64_new(1, -20), dec64_new(1, 20), "1e-20");
+    test_gamma(dec64_new(-1, -20), dec64_new(-1, 20), "-1e-20");
+    test_gamma(dec64_new(935, -1), dec64_new(11979060480944774, 127), "93.5");
+    test_gamma(dec64_new(938, -1), nan, "93.8");
+    test_gamma(dec64_new(1005, -1), nan, "100.5");
+    test_gamma(dec64_new(-805, -1), dec64_new(-48848344, -127), "-80.5");
+    test_gamma(dec64_new(-955, -1), zero, "-95.5");
+}
+
+static void test_all_lgamma() {
+    test_lgamma(nan, nan, "nan");
+    test_lgamma(zero, nan, "0");
+    test_lgamma(dec64_new(-3, 0), nan, "-3");
+    test_lgamma(one, zero, "1");
+    test_lgamma(two, zero, "2");
+    test_lgamma(three, dec64_new(6931471805599453, -16), "3");
+    test_lgamma(ten, dec64_new(1280182748008147, -14), "10");
+    test_lgamma(half, dec64_new(5723649429247001, -16), "1/2");
+    test_lgamma(dec64_new(15, -1), dec64_new(-12078223763524522, -17), "3/2");
+    test_lgamma(dec64_new(25, -1), dec64_new(28468287047291916, -17), "5/2");
+    test_lgamma(dec64_new(1, -1), dec64_new(2252712651734206, -15), "0.1");
+    test_lgamma(dec64_neg(half), dec64_new(12655121234846454, -16), "-1/2");
+    test_lgamma(dec64_new(-25, -1), dec64_new(-5624371649767405, -17), "-5/2");
+    test_lgamma(hundred, dec64_new(3591342053695754, -13), "100");
+    test_lgamma(dec64_new(1000, 0), dec64_new(5905220423209181, -12), "1000");
+    test_lgamma(dec64_new(1, 6), dec64_new(12815504569147612, -9), "1e6");
+    test_lgamma(dec64_new(1, 100), dec64_new(22925850929940457, 86), "1e100");
+    test_lgamma(dec64_new(1, -20), dec64_new(4605170185988091, -14), "1e-20");
+    test_lgamma(dec64_new(-10005, -1), dec64_new(-5914437701116852, -12), "-1000.5");
 }
 
 static void test_all_log() {
     test_log(zero, nan, "0");
-    test_log(cent, dec64_new(-4605170185988091, -16), "0.01");
+    test_log(cent, dec64_new(-4605170185988091, -15), "0.01");
     test_log(half, dec64_new(-6931471805599453, -16), "1/2");
     test_log(one, zero, "1");
     test_log(half_pi, dec64_new(4515827052894549, -16), "pi/2");
@@ -336,6 +490,37 @@ static void test_all_log() {
     test_log(pi, dec64_new(11447298858494002, -16), "pi");
     test_log(ten, dec64_new(23025850929940457, -16), "10");
     test_log(hundred, dec64_new(4605170185988091, -15), "100");
+    test_log(dec64_new(10000001, -7), dec64_new(9999999500000033, -23), "1.0000001");
+    test_log(dec64_new(9999999999, -10), dec64_new(-100000000005, -21), "0.9999999999");
+    test_log(dec64_new(1, -127), dec64_new(-2924283068102438, -13), "1e-127");
+    test_log(maxnum, dec64_new(33055140174104079, -14), "maxnum");
+    test_log(negative_one, nan, "-1");
+    test_log(nan, nan, "nan");
+}
+
+static void test_all_log10() {
+    test_log10(zero, nan, "0");
+    test_log10(one, zero, "1");
+    test_log10(two, dec64_new(3010299956639812, -16), "2");
+    test_log10(e, dec64_new(4342944819032518, -16), "e");
+    test_log10(ten, one, "10");
+    test_log10(hundred, two, "100");
+    test_log10(dec64_new(1, -127), dec64_new(-127, 0), "1e-127");
+    test_log10(dec64_new(103, -2), dec64_new(12837224705172205, -18), "1.03");
+    test_log10(dec64_new(10000001, -7), dec64_new(4342944601885292, -23), "1.0000001");
+    test_log10(negative_one, nan, "-1");
+}
+
+static void test_all_log2() {
+    test_log2(zero, nan, "0");
+    test_log2(half, negative_one, "1/2");
+    test_log2(one, zero, "1");
+    test_log2(two, one, "2");
+    test_log2(e, dec64_new(14426950408889634, -16), "e");
+    test_log2(ten, dec64_new(33219280948873623, -16), "10");
+    test_log2(dec64_new(1024, 0), ten, "1024");
+    test_log2(dec64_new(97, -2), dec64_new(-4394334758759702, -17), "0.97");
+    test_log2(negative_one, nan, "-1");
 }
 
 static void test_all_raise() {
@@ -344,12 +529,121 @@ static void test_all_raise() {
     test_raise(e, half, dec64_new(16487212707001281, -16), "e^0.5");
     test_raise(e, one, e, "e^1");
     test_raise(e, two,  dec64_new(7389056098930650, -15), "e^2");
-    test_raise(e, ten,  dec64_new(22026465794806717, -12), "e^10");
+    test_raise(e, ten,  dec64_new(22026465794806714, -12), "e^10");
     test_raise(four, half,  two, "4^0.5");
     test_raise(two, eleven,  dec64_new(2048, 0), "2^11");
     test_raise(two, ten,  dec64_new(1024, 0), "2^10");
     test_raise(two, five,  dec64_new(32, 0), "2^5");
     test_raise(two, four,  dec64_new(16, 0), "2^4");
+    test_raise(dec64_new(105, -2), dec64_new(12, 0), dec64_new(17958563260221292, -16), "1.05^12");
+    test_raise(two, dec64_new(-10, 0), dec64_new(9765625, -10), "2^-10");
+    test_raise(dec64_new(-2, 0), three, dec64_new(-8, 0), "-2^3");
+    test_raise(dec64_new(-2, 0), half, nan, "-2^0.5");
+    test_raise(two, half, dec64_new(1414213562373095, -15), "2^0.5");
+    test_raise(dec64_new(10000001, -7), dec64_new(1, 7), dec64_new(27182816925449663, -16), "1.0000001^10000000");
+    test_raise(ten, dec64_new(144, 0), nan, "10^144");
+    test_raise(two, dec64_new(-500, 0), zero, "2^-500");
+    test_raise(zero, negative_one, nan, "0^-1");
+    test_raise(nan, two, nan, "nan^2");
+}
+
+static void test_all_pow10() {
+    test_pow10(zero, one, "0");
+    test_pow10(two, hundred, "2");
+    test_pow10(negative_one, dec64_new(1, -1), "-1");
+    test_pow10(dec64_new(143, 0), dec64_new(1, 143), "143");
+    test_pow10(dec64_new(144, 0), nan, "144");
+    test_pow10(dec64_new(-128, 0), zero, "-128");
+    test_pow10(half, dec64_new(31622776601683793, -16), "0.5");
+    test_pow10(nan, nan, "nan");
+}
+
+static void test_all_random() {
+    dec64 results[3];
+    struct dec64_random_state copy;
+    dec64_random_state state;
+
+    dec64_seed(1, 2);
+    judge_unary(one, dec64_new(8192, -16), dec64_random(), "random", "r", "seed 1");
+    judge_unary(two, dec64_new(33024, -16), dec64_random(), "random", "r", "seed 2");
+    state = dec64_random_begin(1, 2);
+    dec64_random_n(state, results, 3);
+    judge_unary(one, dec64_new(8192, -16), results[0], "random_n", "r", "1");
+    judge_unary(two, dec64_new(33024, -16), results[1], "random_n", "r", "2");
+    judge_unary(three, dec64_new(68719510281, -16), results[2], "random_n", "r", "3");
+    judge_unary(four, dec64_new(68719510281, -16), dec64_random(), "random", "r", "seed 3");
+    dec64_random_reseed(state, 1, 2);
+    dec64_random_copy(&copy, state);
+    dec64_random_jump(&copy);
+    judge_unary(one, dec64_new(1629230459589045, -16), dec64_random_next(&copy), "jump", "j", "1");
+    judge_unary(two, dec64_new(8581543328169491, -16), dec64_random_next(&copy), "jump", "j", "2");
+    dec64_random_jump(state);
+    dec64_random_jump(state);
+    judge_unary(one, dec64_new(8221157126885577, -16), dec64_random_next(state), "jump", "j", "twice");
+    dec64_random_copy(&copy, state);
+    judge_unary(two, dec64_new(9540140831481960, -16), dec64_random_next(&copy), "copy", "c", "twice");
+    dec64_random_reseed(state, 0, 0);
+    judge_unary(zero, zero, dec64_random_next(state), "random", "r", "zero seed 1");
+    judge_unary(one, dec64_new(8192, -16), dec64_random_next(state), "random", "r", "zero seed 2");
+    dec64_random_end(state);
+    dec64_random_end(&copy);
+    judge_unary(nan, nan, dec64_random_next(&copy), "random", "r", "ended");
+    dec64_random_reseed(&copy, 1, 2);
+    judge_unary(nan, nan, dec64_random_next(&copy), "random", "r", "reseed ended");
+    judge_unary(nan, nan, dec64_random_next(NULL), "random", "r", "NULL");
+    judge_unary(nan, nan, dec64_random_normal(NULL), "normal", "n", "NULL");
+    judge_binary(one, seven, nan, dec64_random_range(NULL, one, seven), "range", "r", "NULL");
+}
+
+static void test_all_random_distribution() {
+    dec64 results[6];
+    struct dec64_random_state state;
+    int64 at;
+
+    dec64_random_init(&state, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL);
+    judge_unary(one, dec64_new(-15119697541649954, -17), dec64_random_normal(&state), "normal", "n", "1");
+    judge_unary(two, dec64_new(-6199192461355894, -16), dec64_random_normal(&state), "normal", "n", "2");
+    dec64_random_normal_n(&state, results, 2);
+    judge_unary(three, dec64_new(-8335253002320129, -16), results[0], "normal_n", "n", "3");
+    judge_unary(four, dec64_new(15806678937132401, -16), results[1], "normal_n", "n", "4");
+
+    dec64_random_init(&state, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL);
+    judge_unary(one, dec64_new(494523794423018, -15), dec64_random_exponential(&state), "exponential", "x", "1");
+    dec64_random_exponential_n(&state, results, 3);
+    judge_unary(two, dec64_new(23451444978257313, -17), results[0], "exponential_n", "x", "2");
+    judge_unary(three, dec64_new(15436306952652275, -18), results[1], "exponential_n", "x", "3");
+    judge_unary(four, dec64_new(30511427069820631, -16), results[2], "exponential_n", "x", "4");
+
+    dec64_random_init(&state, 0x0123456789ABCDEFULL, 0xFEDCBA9876543210ULL);
+    judge_binary(one, seven, two, dec64_random_range(&state, one, seven), "range", "r", "1");
+    judge_binary(one, seven, two, dec64_random_range(&state, one, seven), "range", "r", "2");
+    dec64_random_range_n(&state, one, seven, results, 4);
+    judge_binary(one, seven, one, results[0], "range_n", "r", "3");
+    judge_binary(one, seven, six, results[1], "range_n", "r", "4");
+    judge_binary(one, seven, six, results[2], "range_n", "r", "5");
+    judge_binary(one, seven, three, results[3], "range_n", "r", "6");
+    judge_binary(five, five, nan, dec64_random_range(&state, five, five), "range", "r", "empty");
+    judge_binary(seven, one, nan, dec64_random_range(&state, seven, one), "range", "r", "backward");
+    judge_binary(half, one, nan, dec64_random_range(&state, half, one), "range", "r", "fraction");
+    judge_binary(nan, one, nan, dec64_random_range(&state, nan, one), "range", "r", "nan");
+    judge_binary(zero, dec64_new(1, 20), nan, dec64_random_range(&state, zero, dec64_new(1, 20)), "range", "r", "too big");
+    judge_binary(dec64_new(10, -1), dec64_new(200, -2), one, dec64_random_range(&state, dec64_new(10, -1), dec64_new(200, -2)), "range", "r", "one choice");
+    dec64_random_range_n(&state, negative_nine, zero, results, 6);
+    for (at = 0; at < 6; at += 1) {
+        judge_binary(
+            negative_nine,
+            zero,
+            dec64_is_less(results[at], zero) == DEC64_TRUE
+            && dec64_is_less(results[at], negative_nine) != DEC64_TRUE
+            && dec64_is_integer(results[at]) == DEC64_TRUE
+            ? results[at]
+            : nan,
+            results[at],
+            "range_n",
+            "r",
+            "in range"
+        );
+    }
 }
 
 static void test_all_root() {
@@ -380,6 +674,21 @@ static void test_all_sin() {
     test_sin(five, dec64_new(-9589242746631385, -16), "5");
     test_sin(ten, dec64_new(-5440211108893698, -16), "10");
     test_sin(dec64_new(-1, 0), dec64_new(-8414709848078965, -16), "-1");
+    test_sin(dec64_new(355, 0), dec64_new(-30144353359488449, -21), "355");
+    test_sin(dec64_new(1, 15), dec64_new(8582727931702358, -16), "1e15");
+    test_sin(dec64_new(1, 22), dec64_new(-8522008497671888, -16), "1e22");
+    test_sin(maxnum, dec64_new(8822361100173514, -17), "maxnum");
+    test_sin(nan, nan, "nan");
+}
+
+static void test_all_sincos() {
+    test_sincos(zero, zero, one, "0");
+    test_sincos(one, dec64_new(8414709848078965, -16), dec64_new(5403023058681397, -16), "1");
+    test_sincos(half_pi, one, zero, "pi/2");
+    test_sincos(pi, zero, negative_one, "pi");
+    test_sincos(dec64_new(-355, 0), dec64_new(30144353359488449, -21), dec64_new(-999999999545659, -15), "-355");
+    test_sincos(dec64_new(1, 100), dec64_new(-3723761236612767, -16), dec64_new(-9280819050746553, -16), "1e100");
+    test_sincos(nan, nan, nan, "nan");
 }
 
 static void test_all_sqrt() {
@@ -393,6 +702,12 @@ static void test_all_sqrt() {
     test_sqrt(dec64_new(100, 0), dec64_new(10, 0), "100");
     test_sqrt(dec64_new(10000, -2), dec64_new(10, 0), "100");
     test_sqrt(dec64_new(1000000, -4), dec64_new(10, 0), "100");
+    test_sqrt(dec64_new(12345678987654321, 0), dec64_new(111111111, 0), "12345678987654321");
+    test_sqrt(dec64_new(25, -1), dec64_new(15811388300841897, -16), "2.5");
+    test_sqrt(dec64_new(1, -127), dec64_new(31622776601683793, -80), "1e-127");
+    test_sqrt(maxnum, dec64_new(6002399271871538, 56), "maxnum");
+    test_sqrt(negative_one, nan, "-1");
+    test_sqrt(nan, nan, "nan");
 }
 
 static void test_all_tan() {
@@ -403,6 +718,9 @@ static void test_all_tan() {
     test_tan(half_pi, nan, "pi/2");
     test_tan(pi, zero, "pi");
     test_tan(ten, dec64_new(6483608274590867, -16), "10");
+    test_tan(dec64_new(47123889803846897, -16), nan, "3pi/2");
+    test_tan(dec64_new(1, 15), dec64_new(-1672414782127583, -15), "1e15");
+    test_tan(dec64_new(-36028797018963967, 127), dec64_new(-8856896842840415, -17), "-maxnum");
 }
 
 static int do_tests(int level_of_detail) {
@@ -421,13 +739,23 @@ static int do_tests(int level_of_detail) {
     test_all_acos();
     test_all_asin();
     test_all_atan();
+    test_all_atan2();
+    test_all_binomial();
     test_all_cos();
     test_all_exp();
     test_all_factorial();
+    test_all_gamma();
+    test_all_lgamma();
     test_all_log();
+    test_all_log10();
+    test_all_log2();
+    test_all_pow10();
     test_all_raise();
+    test_all_random();
+    test_all_random_distribution();
     test_all_root();
     test_all_sin();
+    test_all_sincos();
     test_all_sqrt();
     test_all_tan();
 
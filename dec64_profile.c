@@ -0,0 +1,314 @@
+/*
+dec64_profile.c
+Distributions of DEC64 data.
+
+dec64.com
+2026-10-19
+Public Domain
+
+No warranty.
+
+This file contains the dec64_profile_ functions, which gather histograms of
+the exponents and coefficient widths of DEC64 numbers, count the nans, and
+count the operand pairs whose exponents match. A profile can be fed whole
+arrays, or be called as a sampling hook from the places where a program does
+its arithmetic.
+
+The results tell whether the data would reward a path that assumes a common
+exponent, or a column encoding that stores the exponent once and the
+coefficients in fewer bits. dec64_add, dec64_subtract, and dec64_is_less take
+their fastest paths when the exponents match, and faster still when they are
+both zero.
+*/
+
+#include <stdlib.h>
+#include "dec64.h"
+#include "dec64_profile.h"
+
+static const int64 confirmed = 0xFFDEADFACEC0DECELL;
+
+static int valid(dec64_profile_state state) {
+    return state != NULL && state->valid == confirmed;
+}
+
+static int64 width(int64 coefficient) {
+/*
+    The number of bits in the magnitude of the coefficient. Zero has no bits.
+    The magnitude of the most negative coefficient takes all 56.
+*/
+    uint64 magnitude = (
+        coefficient < 0
+        ? (uint64)0 - (uint64)coefficient
+        : (uint64)coefficient
+    );
+    int64 result = 0;
+    int shift;
+
+    for (shift = 32; shift > 0; shift >>= 1) {
+        if ((magnitude >> shift) != 0) {
+            magnitude >>= shift;
+            result += shift;
+        }
+    }
+    return result + (int64)magnitude;
+}
+
+/* creation */
+
+void dec64_profile_init(dec64_profile_state state) {
+/*
+    Initialize a state object in memory provided by the caller. The memory is
+    not read, so it need not be initialized. A state initialized this way does
+    not need to be passed to dec64_profile_end, but it may be. To empty a
+    profile that is in use, use dec64_profile_clear.
+*/
+    int at;
+
+    if (state != NULL) {
+        state->allocated = 0;
+        state->nr_numbers = 0;
+        state->nr_nan = 0;
+        state->nr_pairs = 0;
+        state->nr_matching = 0;
+        state->nr_integer_pairs = 0;
+        for (at = 0; at < 256; at += 1) {
+            state->exponents[at] = 0;
+        }
+        for (at = 0; at < DEC64_PROFILE_NR_WIDTHS; at += 1) {
+            state->widths[at] = 0;
+        }
+        state->valid = confirmed;
+    }
+}
+
+dec64_profile_state dec64_profile_begin() {
+/*
+    Create a state object that holds a profile. A profile is not shared, so
+    each thread should gather its own, and dec64_profile_merge can combine
+    them at the end. It can return NULL if memory allocation fails.
+*/
+    dec64_profile_state state = (
+        (dec64_profile_state)malloc(sizeof (struct dec64_profile_state))
+    );
+    if (state != NULL) {
+        dec64_profile_init(state);
+        state->allocated = 1;
+    }
+    return state;
+}
+
+void dec64_profile_clear(dec64_profile_state state) {
+/*
+    Empty a profile that is in use so that it can gather a new profile. A state
+    made by dec64_profile_begin must still be passed to dec64_profile_end.
+*/
+    int allocated;
+
+    if (valid(state)) {
+        allocated = state->allocated;
+        dec64_profile_init(state);
+        state->allocated = allocated;
+    }
+}
+
+/* destruction */
+
+void dec64_profile_end(dec64_profile_state state) {
+/*
+    Dispose of the state object. The memory is freed only if the state object
+    was made by dec64_profile_begin.
+*/
+    if (valid(state)) {
+        state->valid = 0;
+        if (state->allocated) {
+            free(state);
+        }
+    }
+}
+
+/* ingestion */
+
+void dec64_profile_number(dec64_profile_state state, dec64 number) {
+/*
+    Add a number to the profile. A nan is counted as a nan, and not in the
+    histograms.
+*/
+    int64 exponent;
+
+    if (valid(state)) {
+        state->nr_numbers += 1;
+        exponent = dec64_exponent(number);
+        if (exponent == -128) {
+            state->nr_nan += 1;
+        } else {
+            state->exponents[exponent + 128] += 1;
+            state->widths[width(dec64_coefficient(number))] += 1;
+        }
+    }
+}
+
+void dec64_profile_numbers(
+    dec64_profile_state state,
+    dec64 numbers[],
+    int64 length
+) {
+    int64 at;
+
+    if (valid(state) && numbers != NULL) {
+        for (at = 0; at < length; at += 1) {
+            dec64_profile_number(state, numbers[at]);
+        }
+    }
+}
+
+void dec64_profile_pair(
+    dec64_profile_state state,
+    dec64 first,
+    dec64 second
+) {
+/*
+    Add the operands of a binary operation to the profile. Both numbers are
+    added, and the pair is counted as matching if neither is nan and their
+    exponents are the same.
+*/
+    int64 exponent;
+
+    if (valid(state)) {
+        dec64_profile_number(state, first);
+        dec64_profile_number(state, second);
+        state->nr_pairs += 1;
+        exponent = dec64_exponent(first);
+        if (exponent != -128 && exponent == dec64_exponent(second)) {
+            state->nr_matching += 1;
+            if (exponent == 0) {
+                state->nr_integer_pairs += 1;
+            }
+        }
+    }
+}
+
+void dec64_profile_pairs(
+    dec64_profile_state state,
+    dec64 firsts[],
+    dec64 seconds[],
+    int64 length
+) {
+/*
+    Add the pairs made by two columns, element by element.
+*/
+    int64 at;
+
+    if (valid(state) && firsts != NULL && seconds != NULL) {
+        for (at = 0; at < length; at += 1) {
+            dec64_profile_pair(state, firsts[at], seconds[at]);
+        }
+    }
+}
+
+void dec64_profile_merge(
+    dec64_profile_state destination,
+    dec64_profile_state source
+) {
+/*
+    Add the source profile into the destination profile. The source is not
+    changed.
+*/
+    int at;
+
+    if (valid(destination) && valid(source) && destination != source) {
+        destination->nr_numbers += source->nr_numbers;
+        destination->nr_nan += source->nr_nan;
+        destination->nr_pairs += source->nr_pairs;
+        destination->nr_matching += source->nr_matching;
+        destination->nr_integer_pairs += source->nr_integer_pairs;
+        for (at = 0; at < 256; at += 1) {
+            destination->exponents[at] += source->exponents[at];
+        }
+        for (at = 0; at < DEC64_PROFILE_NR_WIDTHS; at += 1) {
+            destination->widths[at] += source->widths[at];
+        }
+    }
+}
+
+/* inspection */
+
+int64 dec64_profile_nr_numbers(dec64_profile_state state) {
+    return valid(state) ? state->nr_numbers : 0;
+}
+
+int64 dec64_profile_nr_nan(dec64_profile_state state) {
+    return valid(state) ? state->nr_nan : 0;
+}
+
+int64 dec64_profile_nr_exponent(dec64_profile_state state, int64 exponent) {
+/*
+    The number of numbers with an exponent. The exponent must be between -127
+    and 127. Zeros are counted with whatever exponent they were given.
+*/
+    if (valid(state) && exponent >= -127 && exponent <= 127) {
+        return state->exponents[exponent + 128];
+    }
+    return 0;
+}
+
+int64 dec64_profile_nr_width(dec64_profile_state state, int64 width) {
+/*
+    The number of numbers whose coefficients have a magnitude of width bits.
+    The width must be between 0 and 56.
+*/
+    if (valid(state) && width >= 0 && width < DEC64_PROFILE_NR_WIDTHS) {
+        return state->widths[width];
+    }
+    return 0;
+}
+
+int64 dec64_profile_nr_pairs(dec64_profile_state state) {
+    return valid(state) ? state->nr_pairs : 0;
+}
+
+int64 dec64_profile_nr_matching(dec64_profile_state state) {
+    return valid(state) ? state->nr_matching : 0;
+}
+
+int64 dec64_profile_nr_integer_pairs(dec64_profile_state state) {
+/*
+    The number of pairs whose exponents are both zero. These can take the
+    fastest paths.
+*/
+    return valid(state) ? state->nr_integer_pairs : 0;
+}
+
+int64 dec64_profile_common_exponent(dec64_profile_state state) {
+/*
+    The exponent held by the most numbers. If there is a tie, the least of
+    those exponents is given. If there are no numbers that are not nan, the
+    result is -128.
+*/
+    int at;
+    int64 most = 0;
+    int64 result = -128;
+
+    if (valid(state)) {
+        for (at = 1; at < 256; at += 1) {
+            if (state->exponents[at] > most) {
+                most = state->exponents[at];
+                result = at - 128;
+            }
+        }
+    }
+    return result;
+}
+
+dec64 dec64_profile_matching(dec64_profile_state state) {
+/*
+    The fraction of the pairs whose exponents match, as a DEC64 number between
+    0 and 1. If there are no pairs, the result is nan.
+*/
+    if (!valid(state) || state->nr_pairs == 0) {
+        return DEC64_NULL;
+    }
+    return dec64_divide(
+        dec64_new(state->nr_matching, 0),
+        dec64_new(state->nr_pairs, 0)
+    );
+}
@@ -0,0 +1,124 @@
+/* dec64_profile.h
+
+The dec64_profile header file. This is the companion to dec64_profile.c.
+
+dec64.com
+2026-10-19
+Public Domain
+
+No warranty.
+*/
+
+#define DEC64_PROFILE_NR_WIDTHS 57
+
+typedef struct dec64_profile_state {
+/*
+    For internal use only.
+*/
+    dec64 valid;
+    int allocated;
+    int64 nr_numbers;
+    int64 nr_nan;
+    int64 nr_pairs;
+    int64 nr_matching;
+    int64 nr_integer_pairs;
+    int64 exponents[256];
+    int64 widths[DEC64_PROFILE_NR_WIDTHS];
+}  * dec64_profile_state;
+
+/*
+    creation
+*/
+
+extern dec64_profile_state dec64_profile_begin();
+
+extern void dec64_profile_clear(
+    dec64_profile_state state
+);
+
+extern void dec64_profile_init(
+    dec64_profile_state state
+);
+
+/*
+    destruction
+*/
+
+extern void dec64_profile_end(
+    dec64_profile_state state
+);
+
+/*
+    ingestion
+*/
+
+extern void dec64_profile_number(
+    dec64_profile_state state,
+    dec64 number
+);
+
+extern void dec64_profile_numbers(
+    dec64_profile_state state,
+    dec64 numbers[],
+    int64 length
+);
+
+extern void dec64_profile_pair(
+    dec64_profile_state state,
+    dec64 first,
+    dec64 second
+);
+
+extern void dec64_profile_pairs(
+    dec64_profile_state state,
+    dec64 firsts[],
+    dec64 seconds[],
+    int64 length
+);
+
+extern void dec64_profile_merge(
+    dec64_profile_state destination,
+    dec64_profile_state source
+);
+
+/*
+    inspection
+*/
+
+extern int64 dec64_profile_nr_numbers(
+    dec64_profile_state state
+);
+
+extern int64 dec64_profile_nr_nan(
+    dec64_profile_state state
+);
+
+extern int64 dec64_profile_nr_exponent(
+    dec64_profile_state state,
+    int64 exponent
+);
+
+extern int64 dec64_profile_nr_width(
+    dec64_profile_state state,
+    int64 width
+);
+
+extern int64 dec64_profile_nr_pairs(
+    dec64_profile_state state
+);
+
+extern int64 dec64_profile_nr_matching(
+    dec64_profile_state state
+);
+
+extern int64 dec64_profile_nr_integer_pairs(
+    dec64_profile_state state
+);
+
+extern int64 dec64_profile_common_exponent(
+    dec64_profile_state state
+);
+
+extern dec64 dec64_profile_matching(
+    dec64_profile_state state
+);
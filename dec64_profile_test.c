@@ -0,0 +1,134 @@
+/* dec64_profile_test.c
+
+This is a test of dec64_profile.c.
+
+dec64.com
+2026-10-19
+Public Domain
+
+No warranty.
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "dec64.h"
+#include "dec64_profile.h"
+
+static int level;
+static int nr_fail;
+static int nr_pass;
+
+static void judge(int64 expected, int64 actual, char* name) {
+    if (expected == actual) {
+        nr_pass += 1;
+        if (level >= 3) {
+            printf("\n\npass %s", name);
+        }
+    } else {
+        nr_fail += 1;
+        if (level >= 1) {
+            printf("\n\nFAIL %s", name);
+            if (level >= 2) {
+                printf("\n%-4s%lli", "?", actual);
+                printf("\n%-4s%lli", "=", expected);
+            }
+        }
+    }
+}
+
+static void test_all_numbers() {
+    struct dec64_profile_state profile;
+    dec64 numbers[8];
+
+    numbers[0] = dec64_new(12345, -2);
+    numbers[1] = dec64_new(-1, -2);
+    numbers[2] = DEC64_NULL;
+    numbers[3] = DEC64_ZERO;
+    numbers[4] = dec64_new(7, 0);
+    numbers[5] = dec64_new(36028797018963967, 0);
+    numbers[6] = dec64_new(-36028797018963968, 0);
+    numbers[7] = DEC64_TRUE;
+    dec64_profile_init(&profile);
+    dec64_profile_numbers(&profile, numbers, 8);
+    judge(8, dec64_profile_nr_numbers(&profile), "nr_numbers");
+    judge(2, dec64_profile_nr_nan(&profile), "nr_nan");
+    judge(2, dec64_profile_nr_exponent(&profile, -2), "exponent -2");
+    judge(4, dec64_profile_nr_exponent(&profile, 0), "exponent 0");
+    judge(0, dec64_profile_nr_exponent(&profile, 1), "exponent 1");
+    judge(0, dec64_profile_nr_exponent(&profile, -128), "exponent -128");
+    judge(1, dec64_profile_nr_width(&profile, 0), "width of zero");
+    judge(1, dec64_profile_nr_width(&profile, 1), "width of -1");
+    judge(1, dec64_profile_nr_width(&profile, 3), "width of 7");
+    judge(1, dec64_profile_nr_width(&profile, 14), "width of 12345");
+    judge(1, dec64_profile_nr_width(&profile, 55), "width of maxint");
+    judge(1, dec64_profile_nr_width(&profile, 56), "width of -maxint");
+    judge(0, dec64_profile_nr_width(&profile, 57), "width 57");
+    judge(0, dec64_profile_common_exponent(&profile), "common exponent");
+    judge(DEC64_NULL, dec64_profile_matching(&profile), "no pairs");
+    dec64_profile_end(&profile);
+    judge(0, dec64_profile_nr_numbers(&profile), "after end");
+}
+
+static void test_all_pairs() {
+    dec64_profile_state profile = dec64_profile_begin();
+    dec64_profile_state other = dec64_profile_begin();
+    dec64 firsts[4];
+    dec64 seconds[4];
+
+    firsts[0] = dec64_new(199, -2);
+    seconds[0] = dec64_new(250, -2);
+    firsts[1] = dec64_new(3, 0);
+    seconds[1] = dec64_new(4, 0);
+    firsts[2] = dec64_new(5, -1);
+    seconds[2] = dec64_new(5, -3);
+    firsts[3] = DEC64_NULL;
+    seconds[3] = DEC64_NULL;
+    dec64_profile_pairs(profile, firsts, seconds, 4);
+    judge(4, dec64_profile_nr_pairs(profile), "nr_pairs");
+    judge(8, dec64_profile_nr_numbers(profile), "nr_numbers of pairs");
+    judge(2, dec64_profile_nr_matching(profile), "nr_matching");
+    judge(1, dec64_profile_nr_integer_pairs(profile), "nr_integer_pairs");
+    judge(-2, dec64_profile_common_exponent(profile), "common exponent");
+    judge(
+        DEC64_TRUE,
+        dec64_is_equal(dec64_profile_matching(profile), dec64_new(5, -1)),
+        "matching"
+    );
+    dec64_profile_pair(other, dec64_new(1, -3), dec64_new(2, -3));
+    dec64_profile_pair(other, dec64_new(1, -3), dec64_new(2, -3));
+    dec64_profile_merge(profile, other);
+    judge(6, dec64_profile_nr_pairs(profile), "merged nr_pairs");
+    judge(4, dec64_profile_nr_matching(profile), "merged nr_matching");
+    judge(5, dec64_profile_nr_exponent(profile, -3), "merged exponent -3");
+    judge(-3, dec64_profile_common_exponent(profile), "merged common exponent");
+    judge(2, dec64_profile_nr_pairs(other), "source unchanged");
+    dec64_profile_clear(profile);
+    judge(0, dec64_profile_nr_pairs(profile), "clear");
+    judge(-128, dec64_profile_common_exponent(profile), "empty common exponent");
+    dec64_profile_end(other);
+    dec64_profile_end(profile);
+    judge(0, dec64_profile_nr_pairs(NULL), "NULL");
+}
+
+static int do_tests(int level_of_detail) {
+/*
+    Level of detail:
+        3 full
+        2 errors only
+        1 error summary
+        0 none
+*/
+    level = level_of_detail;
+    nr_fail = 0;
+    nr_pass = 0;
+
+    test_all_numbers();
+    test_all_pairs();
+
+    printf("\n\n%i pass, %i fail.\n", nr_pass, nr_fail);
+    return nr_fail;
+}
+
+int main(int argc, char* argv[]) {
+    return do_tests(2);
+}
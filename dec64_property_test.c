@@ -0,0 +1,371 @@
+/* dec64_property_test.c
+
+This is a property test of dec64.obj and dec64_string.c. Where dec64_test.c
+checks hand picked cases, this checks laws that must hold for every operand,
+over as many generated cases as you care to run, spread over all of the
+cores:
+
+    add commutes            dec64_add(a, b) is dec64_add(b, a), bit for bit
+    multiply commutes       dec64_multiply(a, b) is dec64_multiply(b, a)
+    is_equal is symmetric   dec64_is_equal(a, b) is dec64_is_equal(b, a)
+    add and subtract        (a + b) - b is within the rounding of the two
+                            results of a
+    string round trip       dec64_from_string(dec64_to_string(a)) is equal to a
+    is_less irreflexive     a is not less than a
+    is_less trichotomy      exactly one of a < b, b < a, a = b
+    is_less transitive      if a < b and b < c, then a < c
+
+The operands are mostly the sort that programs use, with small exponents and
+coefficients of every width, but also include edge cases, raw values that are
+not normal, and nans of every kind. Every case is made from its own seed, so a
+failure is reproduced by the same seed and case number regardless of the
+number of threads.
+
+    dec64_property_test [nr_cases] [nr_threads] [seed]
+
+The number of threads is the number of cores unless it is given. It uses C11
+threads.
+
+dec64.com
+2026-10-19
+Public Domain
+
+No warranty.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include "dec64.h"
+#include "dec64_string.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+#define NR_CASES 10000000
+#define NR_EDGES 16
+#define NR_PROPERTIES 8
+#define MAX_THREADS 256
+
+static char* property_names[NR_PROPERTIES] = {
+    "add commutes",
+    "multiply commutes",
+    "is_equal is symmetric",
+    "add and subtract",
+    "string round trip",
+    "is_less irreflexive",
+    "is_less trichotomy",
+    "is_less transitive"
+};
+
+struct failure {
+    int64 case_nr;
+    dec64 first;
+    dec64 second;
+    dec64 third;
+};
+
+struct job {
+    uint64 seed;
+    int64 from;
+    int64 to;
+    int64 nr_checked[NR_PROPERTIES];
+    int64 nr_failed[NR_PROPERTIES];
+    struct failure failures[NR_PROPERTIES];
+};
+
+static struct job jobs[MAX_THREADS];
+static dec64 edges[NR_EDGES];
+
+static void define_edges() {
+    edges[0] = DEC64_ZERO;
+    edges[1] = DEC64_ONE;
+    edges[2] = DEC64_NEGATIVE_ONE;
+    edges[3] = DEC64_NULL;
+    edges[4] = DEC64_TRUE;
+    edges[5] = dec64_new(36028797018963967, 0);
+    edges[6] = dec64_new(-36028797018963968, 0);
+    edges[7] = dec64_new(36028797018963967, 127);
+    edges[8] = dec64_new(-36028797018963968, 127);
+    edges[9] = dec64_new(1, -127);
+    edges[10] = dec64_new(-1, -127);
+    edges[11] = dec64_new(1, -2);
+    edges[12] = dec64_new(5, -1);
+    edges[13] = 0x7F;               /* zero with the largest exponent */
+    edges[14] = 0x181;              /* 1e-127, not normal */
+    edges[15] = dec64_new(10000000000000000, -16);
+}
+
+static uint64 mix(uint64 x) {
+/*
+    splitmix64, which turns a case number into a well scattered seed.
+*/
+    x += 0x9E3779B97F4A7C15;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EB;
+    return x ^ (x >> 31);
+}
+
+static dec64 generate(uint64* seed) {
+/*
+    Make an operand. The exponent byte is written directly, so the operands
+    include numbers that dec64_new would never produce.
+*/
+    uint64 bits;
+    int64 coefficient;
+    int64 exponent;
+    uint64 random;
+    int64 width;
+
+    *seed = mix(*seed);
+    random = *seed;
+    *seed = mix(*seed);
+    bits = *seed;
+    switch (random & 15) {
+    case 0:
+        return edges[(random >> 4) % NR_EDGES];
+    case 1:
+        return (dec64)((bits << 8) | 0x80);
+    case 2:
+    case 3:
+        coefficient = (int64)bits >> 8;
+        exponent = (int64)((random >> 8) % 255) - 127;
+        break;
+    default:
+        width = (int64)((random >> 4) % 56) + 1;
+        coefficient = (int64)(bits >> (64 - width));
+        if (random & 0x10000) {
+            coefficient = -coefficient;
+        }
+        exponent = (int64)((random >> 8) % 41) - 20;
+        break;
+    }
+    return (dec64)(((uint64)coefficient << 8) | (uint64)(exponent & 0xFF));
+}
+
+static int is_nan(dec64 number) {
+    return (number & 0xFF) == 0x80;
+}
+
+static int is_true(dec64 comparison) {
+    return comparison == DEC64_TRUE;
+}
+
+static void judge(
+    struct job* job,
+    int property,
+    int ok,
+    int64 case_nr,
+    dec64 first,
+    dec64 second,
+    dec64 third
+) {
+    job->nr_checked[property] += 1;
+    if (!ok) {
+        if (job->nr_failed[property] == 0) {
+            job->failures[property].case_nr = case_nr;
+            job->failures[property].first = first;
+            job->failures[property].second = second;
+            job->failures[property].third = third;
+        }
+        job->nr_failed[property] += 1;
+    }
+}
+
+static int add_and_subtract(dec64 first, dec64 second) {
+/*
+    The sum can lose up to a unit in its last place, and so can the
+    difference. The difference between the difference and the original must
+    be within those two units.
+*/
+    dec64 bound;
+    dec64 error;
+    dec64 difference;
+    dec64 sum = dec64_add(first, second);
+
+    if (is_nan(first) || is_nan(second) || is_nan(sum)) {
+        return 1;
+    }
+    difference = dec64_subtract(sum, second);
+    if (is_nan(difference)) {
+        return 1;
+    }
+    error = dec64_abs(dec64_subtract(difference, first));
+    bound = dec64_add(
+        dec64_new(1, dec64_exponent(sum)),
+        dec64_new(1, dec64_exponent(difference))
+    );
+    return !is_true(dec64_is_less(bound, error));
+}
+
+static int string_round_trip(
+    dec64_string_state state,
+    dec64_string_char buffer[],
+    dec64 number
+) {
+    if (is_nan(number)) {
+        return 1;
+    }
+    dec64_to_string(state, number, buffer);
+    return is_true(dec64_is_equal(dec64_from_string(state, buffer), number));
+}
+
+static int worker(void* argument) {
+    struct job* job = (struct job*)argument;
+    dec64_string_char buffer[64];
+    int64 case_nr;
+    dec64 a;
+    dec64 b;
+    dec64 c;
+    int a_b;
+    int b_a;
+    int b_c;
+    uint64 seed;
+    struct dec64_string_state state;
+
+    dec64_string_init(&state);
+    for (case_nr = job->from; case_nr < job->to; case_nr += 1) {
+        seed = job->seed ^ mix((uint64)case_nr);
+        a = generate(&seed);
+        b = generate(&seed);
+        c = generate(&seed);
+        judge(
+            job, 0,
+            dec64_add(a, b) == dec64_add(b, a),
+            case_nr, a, b, c
+        );
+        judge(
+            job, 1,
+            dec64_multiply(a, b) == dec64_multiply(b, a),
+            case_nr, a, b, c
+        );
+        judge(
+            job, 2,
+            dec64_is_equal(a, b) == dec64_is_equal(b, a),
+            case_nr, a, b, c
+        );
+        judge(job, 3, add_and_subtract(a, b), case_nr, a, b, c);
+        judge(
+            job, 4,
+            string_round_trip(&state, buffer, a),
+            case_nr, a, b, c
+        );
+        judge(
+            job, 5,
+            !is_true(dec64_is_less(a, a)),
+            case_nr, a, b, c
+        );
+        a_b = is_true(dec64_is_less(a, b));
+        b_a = is_true(dec64_is_less(b, a));
+        judge(
+            job, 6,
+            a_b + b_a + is_true(dec64_is_equal(a, b)) == 1,
+            case_nr, a, b, c
+        );
+        b_c = is_true(dec64_is_less(b, c));
+        judge(
+            job, 7,
+            !(a_b && b_c) || is_true(dec64_is_less(a, c)),
+            case_nr, a, b, c
+        );
+    }
+    dec64_string_end(&state);
+    return 0;
+}
+
+static int nr_cores() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+
+    GetSystemInfo(&info);
+    return (int)info.dwNumberOfProcessors;
+#else
+    long nr = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return nr > 0 ? (int)nr : 1;
+#endif
+}
+
+int main(int argc, char* argv[]) {
+    int64 nr_cases = NR_CASES;
+    int64 nr_fail = 0;
+    int64 nr_pass = 0;
+    int nr_threads = nr_cores();
+    int property;
+    uint64 seed = 0x0123456789ABCDEF;
+    thrd_t threads[MAX_THREADS];
+    int thread_nr;
+
+    if (argc > 1 && atoll(argv[1]) > 0) {
+        nr_cases = atoll(argv[1]);
+    }
+    if (argc > 2 && atoi(argv[2]) > 0) {
+        nr_threads = atoi(argv[2]);
+    }
+    if (argc > 3) {
+        seed = strtoull(argv[3], NULL, 0);
+    }
+    if (nr_threads > MAX_THREADS) {
+        nr_threads = MAX_THREADS;
+    }
+    define_edges();
+    printf(
+        "%lli cases, %i threads, seed 0x%016llX\n",
+        nr_cases,
+        nr_threads,
+        seed
+    );
+    for (thread_nr = 0; thread_nr < nr_threads; thread_nr += 1) {
+        jobs[thread_nr].seed = seed;
+        jobs[thread_nr].from = nr_cases * thread_nr / nr_threads;
+        jobs[thread_nr].to = nr_cases * (thread_nr + 1) / nr_threads;
+        if (
+            thrd_create(&threads[thread_nr], worker, &jobs[thread_nr])
+            != thrd_success
+        ) {
+            fprintf(stderr, "Unable to start thread %i.\n", thread_nr);
+            return 1;
+        }
+    }
+    for (thread_nr = 0; thread_nr < nr_threads; thread_nr += 1) {
+        thrd_join(threads[thread_nr], NULL);
+    }
+
+/*
+    Report each property, with the first failing case found by each thread.
+*/
+
+    for (property = 0; property < NR_PROPERTIES; property += 1) {
+        int64 nr_checked = 0;
+        int64 nr_failed = 0;
+        for (thread_nr = 0; thread_nr < nr_threads; thread_nr += 1) {
+            struct job* job = &jobs[thread_nr];
+            nr_checked += job->nr_checked[property];
+            nr_failed += job->nr_failed[property];
+            if (job->nr_failed[property] > 0) {
+                struct failure* failure = &job->failures[property];
+                printf(
+                    "\nFAIL %s: case %lli\n    %016llX %016llX %016llX\n",
+                    property_names[property],
+                    failure->case_nr,
+                    (uint64)failure->first,
+                    (uint64)failure->second,
+                    (uint64)failure->third
+                );
+            }
+        }
+        printf(
+            "%-24s%lli checked, %lli failed\n",
+            property_names[property],
+            nr_checked,
+            nr_failed
+        );
+        nr_pass += nr_checked - nr_failed;
+        nr_fail += nr_failed;
+    }
+    printf("\n%lli pass, %lli fail.\n", nr_pass, nr_fail);
+    return nr_fail != 0;
+}
@@ -3,13 +3,13 @@ dec64_string.c
 Conversion between DEC64 and strings.
 
 dec64.com
-2018-12-20
+2026-10-18
 Public Domain
 
 No warranty.
 
-This file contains dec64_to_string and dec64_from_string, and dec64_string-*
-configuration functions.
+This file contains dec64_to_string, dec64_from_string, and dec64_from_lines,
+and dec64_string-* configuration functions.
 */
 
 #include <stdlib.h>
@@ -103,6 +103,7 @@ static void emit_digits_separated(dec64_string_state state, int from, int to) {
     int sep;
     if (state->separation <= 0) {
         emit_digits(state, from, to);
+        return;
     }
     sep = to % state->separation;
     if (sep <= 0) {
@@ -145,6 +146,13 @@ static void emit_exponent(dec64_string_state state, int64 exponent) {
     }
 }
 
+static void emit_fill(dec64_string_state state, int c, int count) {
+    while (count > 0) {
+        emit(state, c);
+        count -= 1;
+    }
+}
+
 static void emit_separator(dec64_string_state state) {
     emit(state, state->separator);
 }
@@ -176,6 +184,86 @@ static void emit_scientific(dec64_string_state state) {
     emit_exponent(state, exponent - 1);
 }
 
+static void emit_fixed(dec64_string_state state, dec64 number) {
+    int from;
+    int length;
+    int pad;
+    int whole;
+/*
+    Round the number to the requested number of places. A nan, or a number
+    that became nan, produces a blank field.
+*/
+    if (dec64_is_nan(number) != DEC64_TRUE) {
+        number = dec64_round(number, dec64_new(-state->places, 0));
+    }
+    if (dec64_is_nan(number) == DEC64_TRUE) {
+        emit_fill(state, ' ', state->width);
+        return;
+    }
+    if (number != state->number) {
+        state->number = number;
+        digitize(state);
+    }
+/*
+    Measure the field before emitting anything, so that the padding can be put
+    in front of it. 'from' is the number of digits before the decimal point.
+*/
+    from = state->nr_digits + (int)dec64_exponent(number);
+    whole = (
+        from > 0
+        ? from
+        : 1
+    );
+    length = whole + (number < 0);
+    if (from > 0 && state->separator != 0 && state->separation > 0) {
+        length += (from - 1) / state->separation;
+    }
+    if (state->places > 0) {
+        length += state->places + (state->decimal_point != 0);
+    }
+/*
+    If there is no width, then there is no padding, but a number that could
+    overrun the string is shown in scientific mode instead. If the number does
+    not fit in the width, then the field is filled with '#'.
+*/
+    if (state->width <= 0) {
+        if (length > 31) {
+            if (number < 0) {
+                emit(state, '-');
+            }
+            emit_scientific(state);
+            return;
+        }
+        pad = 0;
+    } else {
+        pad = state->width - length;
+        if (pad < 0) {
+            emit_fill(state, '#', state->width);
+            return;
+        }
+    }
+    if (state->fill == '0') {
+        if (number < 0) {
+            emit(state, '-');
+        }
+        emit_fill(state, '0', pad);
+    } else {
+        emit_fill(state, state->fill, pad);
+        if (number < 0) {
+            emit(state, '-');
+        }
+    }
+    if (from > 0) {
+        emit_digits_separated(state, 0, from);
+    } else {
+        emit(state, '0');
+    }
+    if (state->places > 0) {
+        emit_decimal_point(state);
+        emit_digits(state, from, from + state->places);
+    }
+}
+
 static void emit_standard(dec64_string_state state) {
     int from = 0;
     int to;
@@ -221,18 +309,19 @@ static void emit_standard(dec64_string_state state) {
 
 /* creation */
 
-dec64_string_state dec64_string_begin() {
+void dec64_string_init(dec64_string_state state) {
 /*
-    Create a state object. State objects are passed as the first argument to
-    the other public functions. It holds state so that this module is reentrant
-    and thread safe. Do not manipulate this object directly. Use the functions.
-    It can return NULL if memory allocation fails.
+    Initialize a state object in memory provided by the caller, such as a
+    struct dec64_string_state on the stack. This avoids the allocation done by
+    dec64_string_begin. The memory is not read, so it need not be initialized.
+    A state initialized this way does not need to be passed to
+    dec64_string_end, but it may be. To return a state that is already in use
+    to the defaults, use dec64_string_reset.
 */
-    dec64_string_state state = (
-        (dec64_string_state)malloc(sizeof (struct dec64_string_state))
-    );
     if (state != NULL) {
+        state->allocated = 0;
         state->decimal_point = '.';
+        state->fill = ' ';
         state->mode = standard_mode;
         state->nr_digits = 0;
         state->nr_zeros = 0;
@@ -242,24 +331,86 @@ dec64_string_state dec64_string_begin() {
         state->separator = 0;
         state->string = 0;
         state->valid = confirmed;
+        state->width = 0;
+    }
+}
+
+void dec64_string_copy(
+    dec64_string_state destination,
+    dec64_string_state source
+) {
+/*
+    Initialize the destination state object with the configuration of the
+    source state object. The source is only read, so a configured state can
+    serve as a format that many threads copy into states of their own. If the
+    source is not a valid state object, the destination gets the defaults. Like
+    dec64_string_init, the destination is treated as fresh memory provided by
+    the caller, so it should not be a state made by dec64_string_begin.
+*/
+    if (destination == NULL || destination == source) {
+        return;
+    }
+    dec64_string_init(destination);
+    if (source != NULL && source->valid == confirmed) {
+        destination->decimal_point = source->decimal_point;
+        destination->fill = source->fill;
+        destination->mode = source->mode;
+        destination->places = source->places;
+        destination->separation = source->separation;
+        destination->separator = source->separator;
+        destination->width = source->width;
+    }
+}
+
+dec64_string_state dec64_string_begin() {
+/*
+    Create a state object. State objects are passed as the first argument to
+    the other public functions. It holds state so that this module is reentrant
+    and thread safe. Do not manipulate this object directly. Use the functions.
+    It can return NULL if memory allocation fails.
+*/
+    dec64_string_state state = (
+        (dec64_string_state)malloc(sizeof (struct dec64_string_state))
+    );
+    if (state != NULL) {
+        dec64_string_init(state);
+        state->allocated = 1;
     }
     return state;
 }
 
+void dec64_string_reset(dec64_string_state state) {
+/*
+    Return a state object that is in use to the defaults. Unlike
+    dec64_string_init, it requires a valid state object, and a state made by
+    dec64_string_begin must still be passed to dec64_string_end.
+*/
+    int allocated;
+
+    if (state != NULL && state->valid == confirmed) {
+        allocated = state->allocated;
+        dec64_string_init(state);
+        state->allocated = allocated;
+    }
+}
+
 /* destruction */
 
 void dec64_string_end(dec64_string_state state) {
 /*
-    Dispose of the state object.
+    Dispose of the state object. The memory is freed only if the state object
+    was made by dec64_string_begin.
 */
     if (state != NULL && state->valid == confirmed) {
         state->valid = 0;
-        free(state);
+        if (state->allocated) {
+            free(state);
+        }
     }
 }
 
 /*
-    There are three output modes: standard, scientific, and engineering.
+    There are four output modes: standard, scientific, engineering, and fixed.
     The modes are used by dec64_to_string and ignored by dec64_from_string.
 */
 
@@ -274,6 +425,18 @@ void dec64_string_engineering(dec64_string_state state) {
     }
 }
 
+void dec64_string_fixed(dec64_string_state state) {
+/*
+    Put dec64_to_string into fixed mode, which is used to make aligned columns.
+    The number is rounded to exactly the specified number of places, and is
+    right aligned in a field of the specified width, padded on the left with
+    the fill character.
+*/
+    if (state != NULL && state->valid == confirmed) {
+        state->mode = fixed_mode;
+    }
+}
+
 void dec64_string_scientific(dec64_string_state state) {
 /*
     Put dec64_to_string into scientific mode, in which the coefficient is
@@ -312,10 +475,26 @@ void dec64_string_decimal_point(
     }
 }
 
+void dec64_string_fill(dec64_string_state state, dec64_string_char fill) {
+/*
+    Specify the character used to pad fields in fixed mode. The default is
+    ' '. If it is '0', then the zeros go after the minus sign. A fill that
+    could not be emitted, such as '\0', would make the field short, so it is
+    taken as ' '.
+*/
+    if (state != NULL && state->valid == confirmed) {
+        if (fill <= 0) {
+            fill = ' ';
+        }
+        state->fill = fill;
+    }
+}
+
 void dec64_string_places(dec64_string_state state, dec64_string_char places) {
 /*
     Specify the minimum number of decimal places output by dec64_to_string in
-    standard mode. This is commonly used to format money values.
+    standard mode. This is commonly used to format money values. In fixed mode,
+    it is the exact number of decimal places.
 */
     if (state != NULL && state->valid == confirmed) {
         state->places = places;
@@ -353,14 +532,39 @@ void dec64_string_separator(
     }
 }
 
-/* Action. */
+void dec64_string_width(dec64_string_state state, int width) {
+/*
+    Specify the width of the field produced by dec64_to_string in fixed mode.
+    The default is 0, meaning no padding.
+*/
+    if (state != NULL && state->valid == confirmed) {
+        if (width < 0) {
+            width = 0;
+        }
+        state->width = width;
+    }
+}
 
-dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
+/* functions in service to dec64_from_string and dec64_from_lines */
+
+static int char_at(dec64_string_char string[], int64 at, int64 length) {
 /*
-    Convert a string into a dec64. If conversion is not possible for any
-    reason, the result will be DEC64_NULL.
+    Fetch a character. Everything at or past the length reads as '\0', so a
+    line can be parsed in place without being copied or terminated.
 */
-    int at;
+    return (
+        at < length
+        ? string[at]
+        : 0
+    );
+}
+
+static dec64 parse(
+    dec64_string_state state,
+    dec64_string_char string[],
+    int64 length
+) {
+    int64 at;
     int c;
     int digits;
     int leading;
@@ -373,13 +577,10 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
     int64 sign;
     int64 sign_exp;
 
-    if (state == NULL || state->valid != confirmed || string == NULL) {
-        return DEC64_NULL;
-    }
 /*
     Get the first character.
 */
-    c = string[0];
+    c = char_at(string, 0, length);
     coefficient = 0;
     digits = 0;
     exponent = 0;
@@ -390,7 +591,7 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
     Minus sign.
 */
     if (c == '-') {
-        c = string[1];
+        c = char_at(string, 1, length);
         at = 1;
         sign = -1;
     } else {
@@ -478,17 +679,17 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
                         exp = 0;
                         sign_exp = 1;
                         at += 1;
-                        c = string[at];
+                        c = char_at(string, at, length);
 /*
     Optional minus or plus
 */
                         if (c == '-') {
                             sign_exp = -1;
                             at += 1;
-                            c = string[at];
+                            c = char_at(string, at, length);
                         } else if (c == '+') {
                             at += 1;
-                            c = string[at];
+                            c = char_at(string, at, length);
                         }
 /*
     The exponent digits.
@@ -504,7 +705,7 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
                                 return DEC64_NULL;
                             }
                             at += 1;
-                            c = string[at];
+                            c = char_at(string, at, length);
                         }
                     }
 /*
@@ -527,7 +728,7 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
     Get the next charcter.
 */
         at += 1;
-        c = string[at];
+        c = char_at(string, at, length);
     }
 /*
     If everything is ok, return the number.
@@ -539,6 +740,133 @@ dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
     );
 }
 
+static int64 line_end(dec64_string_char text[], int64 at, int64 length) {
+/*
+    Find the position of the '\n' that ends the line starting at 'at', or the
+    length if the last line is not terminated.
+*/
+    while (at < length && text[at] != '\n') {
+        at += 1;
+    }
+    return at;
+}
+
+/* Action. */
+
+dec64 dec64_from_string(dec64_string_state state, dec64_string_char string[]) {
+/*
+    Convert a string into a dec64. If conversion is not possible for any
+    reason, the result will be DEC64_NULL.
+*/
+    if (state == NULL || state->valid != confirmed || string == NULL) {
+        return DEC64_NULL;
+    }
+    return parse(state, string, 0x7FFFFFFFFFFFFFFFLL);
+}
+
+int64 dec64_from_lines(
+    dec64_string_state state,
+    dec64_string_char text[],
+    int64 length,
+    dec64 numbers[],
+    int64 capacity
+) {
+/*
+    Convert a text of length characters containing one number per line into
+    the numbers array. The text does not need to be '\0' terminated. Lines end
+    with '\n' or "\r\n". A line that can not be converted produces DEC64_NULL,
+    so numbers[i] always corresponds to line i. A final '\n' does not start
+    another line. It returns the number of numbers deposited, which will not
+    exceed capacity.
+
+    The text is only read, so several threads can convert different parts of
+    the same text at once, each with its own state object. See
+    dec64_string_split.
+*/
+    int64 at;
+    int64 end;
+    int64 nr_numbers;
+    int64 stop;
+
+    if (
+        state == NULL
+        || state->valid != confirmed
+        || text == NULL
+        || numbers == NULL
+    ) {
+        return 0;
+    }
+    at = 0;
+    nr_numbers = 0;
+    while (at < length && nr_numbers < capacity) {
+        end = line_end(text, at, length);
+        stop = end;
+        if (stop > at && text[stop - 1] == '\r') {
+            stop -= 1;
+        }
+        numbers[nr_numbers] = parse(state, text + at, stop - at);
+        nr_numbers += 1;
+        at = end + 1;
+    }
+    return nr_numbers;
+}
+
+int64 dec64_string_lines(dec64_string_char text[], int64 length) {
+/*
+    Count the lines in a text, using the same rules as dec64_from_lines. This
+    is the number of numbers that dec64_from_lines would produce.
+*/
+    int64 at;
+    int64 nr_lines;
+
+    if (text == NULL) {
+        return 0;
+    }
+    nr_lines = 0;
+    for (at = 0; at < length; at = line_end(text, at, length) + 1) {
+        nr_lines += 1;
+    }
+    return nr_lines;
+}
+
+void dec64_string_split(
+    dec64_string_char text[],
+    int64 length,
+    int64 nr_chunks,
+    int64 bounds[]
+) {
+/*
+    Divide a text into nr_chunks chunks of roughly equal size that begin and
+    end on line boundaries. bounds must have room for nr_chunks + 1 positions.
+    Chunk i runs from bounds[i] up to bounds[i + 1]. Some chunks can be empty
+    if the lines are long or the text is short.
+
+    A large text can be converted in parallel: count the lines in each chunk
+    with dec64_string_lines, add up the counts to find where each chunk's
+    numbers go, and then give each chunk and its own state object to a
+    thread that calls dec64_from_lines. The results are in the same order as
+    they would be if the whole text were converted at once.
+*/
+    int64 at;
+    int64 chunk;
+
+    if (text == NULL || bounds == NULL || nr_chunks < 1) {
+        return;
+    }
+    bounds[0] = 0;
+    at = 0;
+    for (chunk = 1; chunk < nr_chunks; chunk += 1) {
+        if (at < (length * chunk) / nr_chunks) {
+            at = line_end(text, (length * chunk) / nr_chunks, length) + 1;
+            if (at > length) {
+                at = length;
+            }
+        }
+        bounds[chunk] = at;
+    }
+    bounds[nr_chunks] = length;
+}
+
 int dec64_to_string(
     dec64_string_state state,
     dec64 number,
@@ -558,6 +886,10 @@ int dec64_to_string(
     would require more than 17 digits, which would be due to excessive
     trailing zeros or zeros immediately after the decimal point. In that
     case scientific notation will be used instead.
+
+    In fixed mode, exactly width characters are deposited, so the string must
+    have capacity for width + 1 characters. Fields can be deposited one after
+    another into a row without measuring them.
 */
     if (state == NULL || state->valid != confirmed) {
         return 0;
@@ -565,7 +897,9 @@ int dec64_to_string(
 
     state->length = 0;
     state->string = string;
-    if (dec64_is_nan(number) != DEC64_TRUE) {
+    if (state->mode == fixed_mode) {
+        emit_fixed(state, number);
+    } else if (dec64_is_nan(number) != DEC64_TRUE) {
         if (dec64_is_zero(number) == DEC64_TRUE) {
             emit(state, '0');
         } else {
@@ -580,6 +914,8 @@ int dec64_to_string(
             case engineering_mode:
                 emit_engineering(state);
                 break;
+            case fixed_mode:
+                break;
             case scientific_mode:
                 emit_scientific(state);
                 break;
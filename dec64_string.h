@@ -3,7 +3,7 @@
 The dec64_string header file. This is the companion to dec64_string.c.
 
 dec64.com
-2018-12-20
+2026-10-18
 Public Domain
 
 No warranty.
@@ -11,6 +11,7 @@ No warranty.
 
 enum dec64_string_mode {
     engineering_mode,
+    fixed_mode,
     scientific_mode,
     standard_mode
 };
@@ -22,6 +23,7 @@ typedef struct dec64_string_state {
     For internal use only.
 */
     dec64 valid;
+    int allocated;
     dec64 number;
     dec64_string_char* string;
     int digits[32];
@@ -30,8 +32,10 @@ typedef struct dec64_string_state {
     int nr_zeros;
     int places;
     int separation;
+    int width;
     enum dec64_string_mode mode;
     dec64_string_char decimal_point;
+    dec64_string_char fill;
     dec64_string_char separator;
 }  * dec64_string_state;
 
@@ -41,6 +45,19 @@ typedef struct dec64_string_state {
 
 extern dec64_string_state dec64_string_begin();
 
+extern void dec64_string_copy(
+    dec64_string_state destination,
+    dec64_string_state source
+);
+
+extern void dec64_string_init(
+    dec64_string_state state
+);
+
+extern void dec64_string_reset(
+    dec64_string_state state
+);
+
 /*
     destruction
 */
@@ -62,6 +79,15 @@ extern void dec64_string_engineering(
     dec64_string_state state
 );
 
+extern void dec64_string_fill(
+    dec64_string_state state,
+    dec64_string_char fill
+);
+
+extern void dec64_string_fixed(
+    dec64_string_state state
+);
+
 extern void dec64_string_places(
     dec64_string_state state,
     dec64_string_char places
@@ -85,6 +111,27 @@ extern void dec64_string_standard(
     dec64_string_state state
 );
 
+extern void dec64_string_width(
+    dec64_string_state state,
+    int width
+);
+
+/*
+    division
+*/
+
+extern int64 dec64_string_lines(
+    dec64_string_char text[],
+    int64 length
+);
+
+extern void dec64_string_split(
+    dec64_string_char text[],
+    int64 length,
+    int64 nr_chunks,
+    int64 bounds[]
+);
+
 /*
     action
 */
@@ -94,6 +141,14 @@ extern dec64 dec64_from_string(
     dec64_string_char string[]
 );
 
+extern int64 dec64_from_lines(
+    dec64_string_state state,
+    dec64_string_char text[],
+    int64 length,
+    dec64 numbers[],
+    int64 capacity
+);
+
 extern int dec64_to_string(
     dec64_string_state state,
     dec64 number,
@@ -0,0 +1,328 @@
+/* dec64_string_bench.c
+
+This is a benchmark of dec64_string.c. It measures dec64_from_string,
+dec64_from_lines, and dec64_to_string over generated corpora that resemble
+the numbers that programs actually read and write:
+
+    price       short amounts of money, like 123.45
+    long        17 digit values that use the whole coefficient
+    scientific  values with large and small exponents, like 6.02214076e23
+    separated   large amounts with separators, like 1,234,567.89
+
+Each corpus is parsed with dec64_from_string one string at a time, and as a
+single text with dec64_from_lines. Each corpus is formatted in each mode:
+
+    standard    the default state
+    places      standard mode with 2 places
+    separator   standard mode with ',' separators
+    scientific  scientific mode
+    engineering engineering mode
+    fixed       fixed mode with 2 places in a width of 24
+
+Each measurement is the median of several runs. The results are written as
+comma separated values, one line per case, so that they can be kept and
+compared:
+
+    function,corpus,mode,ns_per_value,values_per_second,mb_per_second
+
+Megabytes are the characters read or written, in millions. The number of
+values in each corpus can be given as the first argument.
+
+dec64.com
+2026-10-18
+Public Domain
+
+No warranty.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "dec64.h"
+#include "dec64_string.h"
+
+#define NR_RUNS 5
+#define NR_VALUES 100000
+#define STRIDE 32
+
+struct corpus {
+    char* name;
+    dec64* numbers;
+    dec64_string_char* strings;
+    dec64_string_char* text;
+    int64 text_length;
+    dec64_string_char separator;
+};
+
+static struct corpus corpora[4];
+static int nr_corpora;
+static int64 nr_values;
+static dec64* results;
+static dec64_string_char buffer[STRIDE];
+static volatile int64 sink;
+static uint64 seed = 0x0123456789ABCDEF;
+
+static uint64 next() {
+/*
+    A small xorshift generator, so that the corpora are the same on every run
+    and do not depend on dec64_math.c.
+*/
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+}
+
+static int64 below(int64 limit) {
+    return (int64)(next() % (uint64)limit);
+}
+
+static int64 sign() {
+    return (next() & 1) ? -1 : 1;
+}
+
+static void make_corpus(char* name, int kind) {
+/*
+    Generate the numbers, and then write them as strings in the way that the
+    corpus calls for. The strings are kept both separately, each in its own
+    STRIDE characters, and together as a text of lines.
+*/
+    int64 at;
+    struct corpus* c = &corpora[nr_corpora];
+    int64 length;
+    dec64_string_state state = dec64_string_begin();
+
+    c->name = name;
+    c->numbers = (dec64*)malloc(sizeof(dec64) * nr_values);
+    c->strings = (dec64_string_char*)malloc(STRIDE * nr_values);
+    c->text = (dec64_string_char*)malloc(STRIDE * nr_values);
+    c->text_length = 0;
+    c->separator = 0;
+    if (c->numbers == NULL || c->strings == NULL || c->text == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        exit(1);
+    }
+    if (kind == 2) {
+        dec64_string_scientific(state);
+    } else if (kind == 3) {
+        c->separator = ',';
+        dec64_string_separator(state, ',');
+    }
+    for (at = 0; at < nr_values; at += 1) {
+        dec64 number;
+        switch (kind) {
+        case 0:
+            number = dec64_new(below(100000) + 1, -2);
+            break;
+        case 1:
+            number = dec64_new(
+                sign() * (10000000000000000 + below(20000000000000000)),
+                -below(17)
+            );
+            break;
+        case 2:
+            number = dec64_new(
+                sign() * (100000000000 + below(900000000000)),
+                below(200) - 110
+            );
+            break;
+        default:
+            number = dec64_new(100000000 + below(100000000000000), -2);
+            break;
+        }
+        c->numbers[at] = number;
+        length = dec64_to_string(state, number, &c->strings[at * STRIDE]);
+        memcpy(&c->text[c->text_length], &c->strings[at * STRIDE], length);
+        c->text_length += length;
+        c->text[c->text_length] = '\n';
+        c->text_length += 1;
+    }
+    dec64_string_end(state);
+    nr_corpora += 1;
+}
+
+static void check_corpus(struct corpus* c) {
+/*
+    Make sure that the strings read back as the numbers they were made from,
+    so that the parse benchmarks measure the real work.
+*/
+    int64 at;
+    int64 nr_bad = 0;
+    dec64_string_state state = dec64_string_begin();
+
+    dec64_string_separator(state, c->separator);
+    for (at = 0; at < nr_values; at += 1) {
+        dec64 number = dec64_from_string(state, &c->strings[at * STRIDE]);
+        if (dec64_is_equal(number, c->numbers[at]) != DEC64_TRUE) {
+            nr_bad += 1;
+        }
+    }
+    if (
+        dec64_from_lines(
+            state,
+            c->text,
+            c->text_length,
+            results,
+            nr_values
+        ) != nr_values
+    ) {
+        nr_bad += 1;
+    }
+    if (nr_bad > 0) {
+        fprintf(stderr, "%s: %lld values do not read back.\n", c->name, nr_bad);
+    }
+    dec64_string_end(state);
+}
+
+static double now() {
+/*
+    The time in nanoseconds.
+*/
+    struct timespec time;
+
+    timespec_get(&time, TIME_UTC);
+    return (double)time.tv_sec * 1e9 + (double)time.tv_nsec;
+}
+
+static double parse_strings(dec64_string_state state, struct corpus* c) {
+    int64 at;
+    double start = now();
+
+    for (at = 0; at < nr_values; at += 1) {
+        results[at] = dec64_from_string(state, &c->strings[at * STRIDE]);
+    }
+    return now() - start;
+}
+
+static double parse_lines(dec64_string_state state, struct corpus* c) {
+    double start = now();
+
+    dec64_from_lines(state, c->text, c->text_length, results, nr_values);
+    return now() - start;
+}
+
+static double format(dec64_string_state state, struct corpus* c) {
+    int64 at;
+    int64 length = 0;
+    double start = now();
+
+    for (at = 0; at < nr_values; at += 1) {
+        length += dec64_to_string(state, c->numbers[at], buffer);
+    }
+    sink = length;
+    return now() - start;
+}
+
+static int64 format_length(dec64_string_state state, struct corpus* c) {
+/*
+    Count the characters that a mode produces. This also warms the caches
+    before the runs.
+*/
+    int64 at;
+    int64 length = 0;
+
+    for (at = 0; at < nr_values; at += 1) {
+        length += dec64_to_string(state, c->numbers[at], buffer);
+    }
+    return length;
+}
+
+static int compare_doubles(const void* a, const void* b) {
+    double first = *(const double*)a;
+    double second = *(const double*)b;
+    return (first > second) - (first < second);
+}
+
+static void report(
+    char* function_name,
+    struct corpus* c,
+    char* mode_name,
+    double (*function)(dec64_string_state, struct corpus*),
+    dec64_string_state state,
+    int64 nr_characters
+) {
+/*
+    Take the median of the runs, and write a line.
+*/
+    double ns;
+    double runs[NR_RUNS];
+    int run_nr;
+
+    for (run_nr = 0; run_nr < NR_RUNS; run_nr += 1) {
+        runs[run_nr] = function(state, c);
+    }
+    qsort(runs, NR_RUNS, sizeof(double), compare_doubles);
+    ns = runs[NR_RUNS / 2];
+    if (ns <= 0) {
+        ns = 1;
+    }
+    printf(
+        "%s,%s,%s,%.3f,%.0f,%.3f\n",
+        function_name,
+        c->name,
+        mode_name,
+        ns / (double)nr_values,
+        (double)nr_values * 1e9 / ns,
+        (double)nr_characters * 1e3 / ns
+    );
+}
+
+static void bench_corpus(struct corpus* c) {
+    int64 at;
+    int64 nr_characters = 0;
+    dec64_string_state state = dec64_string_begin();
+
+    for (at = 0; at < nr_values; at += 1) {
+        nr_characters += (int64)strlen(&c->strings[at * STRIDE]);
+    }
+    dec64_string_separator(state, c->separator);
+    report("from_string", c, "standard", parse_strings, state, nr_characters);
+    report("from_lines", c, "standard", parse_lines, state, c->text_length);
+
+    dec64_string_reset(state);
+    report("to_string", c, "standard", format, state, format_length(state, c));
+    dec64_string_places(state, 2);
+    report("to_string", c, "places", format, state, format_length(state, c));
+    dec64_string_reset(state);
+    dec64_string_separator(state, ',');
+    report("to_string", c, "separator", format, state, format_length(state, c));
+    dec64_string_reset(state);
+    dec64_string_scientific(state);
+    report("to_string", c, "scientific", format, state, format_length(state, c));
+    dec64_string_engineering(state);
+    report("to_string", c, "engineering", format, state, format_length(state, c));
+    dec64_string_reset(state);
+    dec64_string_fixed(state);
+    dec64_string_places(state, 2);
+    dec64_string_width(state, 24);
+    report("to_string", c, "fixed", format, state, format_length(state, c));
+    dec64_string_end(state);
+}
+
+int main(int argc, char* argv[]) {
+    int corpus_nr;
+
+    nr_values = NR_VALUES;
+    if (argc > 1) {
+        nr_values = atoll(argv[1]);
+        if (nr_values <= 0) {
+            nr_values = NR_VALUES;
+        }
+    }
+    results = (dec64*)malloc(sizeof(dec64) * nr_values);
+    if (results == NULL) {
+        fprintf(stderr, "Out of memory.\n");
+        return 1;
+    }
+    make_corpus("price", 0);
+    make_corpus("long", 1);
+    make_corpus("scientific", 2);
+    make_corpus("separated", 3);
+    printf("function,corpus,mode,ns_per_value,values_per_second,mb_per_second\n");
+    for (corpus_nr = 0; corpus_nr < nr_corpora; corpus_nr += 1) {
+        check_corpus(&corpora[corpus_nr]);
+        bench_corpus(&corpora[corpus_nr]);
+    }
+    return 0;
+}
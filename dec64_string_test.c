@@ -411,6 +411,82 @@ static void test_to_engineering() {
     test_to(dec64_new(1024, 0), "1.024e3");
 }
 
+static void test_to_fixed() {
+    dec64_string_char row[40];
+    int at;
+
+    dec64_string_fixed(state);
+    dec64_string_separator(state, 0);
+    dec64_string_places(state, 2);
+    dec64_string_width(state, 10);
+    dec64_string_fill(state, ' ');
+
+    test_to(nan, "          ");
+    test_to(zero, "      0.00");
+    test_to(zip, "      0.00");
+    test_to(one, "      1.00");
+    test_to(cent, "      0.01");
+    test_to(half, "      0.50");
+    test_to(pi, "      3.14");
+    test_to(negative_pi, "     -3.14");
+    test_to(dec64_new(5, -3), "      0.01");
+    test_to(dec64_new(-5, -3), "     -0.01");
+    test_to(dec64_new(4, -3), "      0.00");
+    test_to(dec64_new(-4, -3), "      0.00");
+    test_to(dec64_new(9995, -3), "     10.00");
+    test_to(dec64_new(12345, -2), "    123.45");
+    test_to(dec64_new(1234567, -1), " 123456.70");
+    test_to(dec64_new(12345678, -1), "1234567.80");
+    test_to(dec64_new(123456789, -1), "##########");
+    test_to(dec64_new(1, 20), "##########");
+    test_to(minnum, "      0.00");
+
+    dec64_string_separator(state, ',');
+    test_to(dec64_new(12345678, -1), "##########");
+    test_to(dec64_new(1234567, -1), "123,456.70");
+    test_to(dec64_new(123456, -1), " 12,345.60");
+
+    dec64_string_fill(state, 0);
+    test_to(dec64_new(123456, -1), " 12,345.60");
+
+    dec64_string_fill(state, '0');
+    test_to(dec64_new(123456, -1), "012,345.60");
+    test_to(negative_pi, "-000003.14");
+    test_to(zero, "0000000.00");
+
+    dec64_string_separator(state, 0);
+    dec64_string_places(state, 0);
+    dec64_string_width(state, 4);
+    test_to(dec64_new(5, -1), "0001");
+    test_to(dec64_new(-15, -1), "-002");
+    test_to(dec64_new(9999, 0), "9999");
+
+    dec64_string_width(state, 0);
+    test_to(dec64_new(-15, -1), "-2");
+    test_to(maxnum, "3.6028797018963967e143");
+
+    dec64_string_fill(state, ' ');
+    dec64_string_places(state, 3);
+    dec64_string_width(state, 8);
+    at = dec64_to_string(state, pi, row);
+    at += dec64_to_string(state, negative_one, row + at);
+    at += dec64_to_string(state, nan, row + at);
+    at += dec64_to_string(state, cent, row + at);
+    if (at == 32 && strcmp(row, "   3.142  -1.000           0.010") == 0) {
+        nr_pass += 1;
+    } else {
+        nr_fail += 1;
+        if (level >= 1) {
+            printf("\n\nFAIL to: row\n%-4s\"%s\"", "?", row);
+        }
+    }
+
+    dec64_string_separator(state, ',');
+    dec64_string_width(state, 0);
+    dec64_string_places(state, 0);
+    dec64_string_standard(state);
+}
+
 static void test_all_from() {
     test_from("", nan);
     test_from("nan", nan);
@@ -552,6 +628,145 @@ static void test_all_from() {
     test_from("1.2345e-3", dec64_new(12345, -7));
 }
 
+static void test_lines(
+    dec64_string_char * text,
+    int64 nr_chunks,
+    dec64 expected[],
+    int64 nr_expected
+) {
+/*
+    Convert the text one chunk at a time, each chunk with its own state, as
+    worker threads would, and compare the assembled result with expected.
+*/
+    dec64 actual[16];
+    int64 at;
+    int64 bounds[9];
+    int64 chunk;
+    dec64_string_state chunk_state;
+    int64 length = (int64)strlen(text);
+    int64 nr_actual = 0;
+    int ok;
+
+    dec64_string_split(text, length, nr_chunks, bounds);
+    for (chunk = 0; chunk < nr_chunks; chunk += 1) {
+        chunk_state = dec64_string_begin();
+        nr_actual += dec64_from_lines(
+            chunk_state,
+            text + bounds[chunk],
+            bounds[chunk + 1] - bounds[chunk],
+            actual + nr_actual,
+            16 - nr_actual
+        );
+        dec64_string_end(chunk_state);
+    }
+    ok = (
+        nr_actual == nr_expected
+        && dec64_string_lines(text, length) == nr_expected
+    );
+    for (at = 0; ok && at < nr_expected; at += 1) {
+        ok = (
+            actual[at] == expected[at]
+            || dec64_is_equal(actual[at], expected[at]) == DEC64_TRUE
+        );
+    }
+    if (ok) {
+        nr_pass += 1;
+        if (level >= 3) {
+            printf("\n\npass lines: %lli chunks, %lli lines", nr_chunks, nr_actual);
+        }
+    } else {
+        nr_fail += 1;
+        if (level >= 1) {
+            printf("\n\nFAIL lines: %lli chunks", nr_chunks);
+            if (level >= 2) {
+                for (at = 0; at < nr_actual; at += 1) {
+                    printf("\n%-4s", "?");
+                    print_dec64(actual[at]);
+                }
+                for (at = 0; at < nr_expected; at += 1) {
+                    printf("\n%-4s", "=");
+                    print_dec64(expected[at]);
+                }
+            }
+        }
+    }
+}
+
+static void test_all_copy() {
+/*
+    Format with states that live on the stack, configured by copying a shared
+    state, and then restore the shared state.
+*/
+    dec64_string_state shared = state;
+    struct dec64_string_state format;
+    struct dec64_string_state local;
+
+    dec64_string_init(&format);
+    dec64_string_separator(&format, ',');
+    dec64_string_places(&format, 2);
+    dec64_string_copy(&local, &format);
+    state = &local;
+    test_to(dec64_new(1234567, -1), "123,456.70");
+    test_to(cent, "0.01");
+    test_to(nan, "");
+    test_from("1,234.50", dec64_new(12345, -1));
+    dec64_string_end(&local);
+
+    dec64_string_copy(&local, NULL);
+    test_to(dec64_new(1234567, -1), "123456.7");
+
+    dec64_string_copy(&local, &format);
+    dec64_string_copy(&local, &local);
+    test_to(dec64_new(1234567, -1), "123,456.70");
+
+/*
+    Reset a state made by dec64_string_begin. It must still be freed by
+    dec64_string_end.
+*/
+
+    state = dec64_string_begin();
+    dec64_string_separator(state, ',');
+    dec64_string_reset(state);
+    test_to(dec64_new(1234567, -1), "123456.7");
+    dec64_string_end(state);
+    state = shared;
+}
+
+static void test_all_lines() {
+    dec64 prices[7];
+    prices[0] = one;
+    prices[1] = dec64_new(12345, -2);
+    prices[2] = nan;
+    prices[3] = negative_pi;
+    prices[4] = dec64_new(1, 6);
+    prices[5] = cent;
+    prices[6] = zero;
+
+    test_lines("", 1, prices, 0);
+    test_lines("", 4, prices, 0);
+    test_lines("1", 1, prices, 1);
+    test_lines("1\n", 3, prices, 1);
+    test_lines("1\r\n123.45\r\n", 2, prices, 2);
+    test_lines(
+        "1\n123.45\nnan\n-3.1415926535897932\n1e6\n0.01\n0",
+        1,
+        prices,
+        7
+    );
+    test_lines(
+        "1\n123.45\nnan\n-3.1415926535897932\n1e6\n0.01\n0\n",
+        3,
+        prices,
+        7
+    );
+    test_lines(
+        "1\r\n123.45\r\n\r\n-3.1415926535897932\r\n1e6\r\n0.01\r\n0",
+        8,
+        prices,
+        7
+    );
+}
+
 static int do_tests(int level_of_detail) {
 /*
     Level of detail:
@@ -570,8 +785,11 @@ static int do_tests(int level_of_detail) {
     test_to_place();
     test_to_scientific();
     test_to_engineering();
+    test_to_fixed();
 
     test_all_from();
+    test_all_lines();
+    test_all_copy();
 
     printf("\n\n%i pass, %i fail.\n", nr_pass, nr_fail);
     dec64_string_end(state);
@@ -1,6 +1,8 @@
 /* dec64_test.c
 
-This is a test of dec64.obj.
+This is a test of dec64.obj. Compile it with DEC64_STATS defined when
+dec64.asm was assembled with STATS set to 1, so that the slow path counts are
+tested too.
 
 dec64.com
 2025-12-14
@@ -15,6 +17,12 @@ No warranty.
 #define false DEC64_FALSE
 #define true  DEC64_TRUE
 
+#ifdef DEC64_STATS
+#define COUNTED 1
+#else
+#define COUNTED 0
+#endif
+
 static int level;
 static int nr_fail;
 static int nr_pass;
@@ -312,6 +320,30 @@ static void judge_communitive(
     }
 }
 
+static void judge_stats(
+    int64 expected,
+    int64 actual,
+    char* name,
+    char* comment
+) {
+    if (expected == actual) {
+        nr_pass += 1;
+        if (level >= 3) {
+            printf("\n\npass %s: %s", name, comment);
+            printf("\n%-4s%lld", "=", actual);
+        }
+    } else {
+        nr_fail += 1;
+        if (level >= 1) {
+            printf("\n\nFAIL %s: %s", name, comment);
+            if (level >= 2) {
+                printf("\n%-4s%lld", "?", actual);
+                printf("\n%-4s%lld", "=", expected);
+            }
+        }
+    }
+}
+
 static void test_abs(dec64 first, dec64 expected, char* comment) {
     dec64 actual = dec64_abs(first);
     judge_unary(first, expected, actual, "abs", "a", comment);
@@ -548,6 +580,10 @@ static void test_all_add() {
     test_add(dec64_new(7182818284590704, -16), dec64_new(10, -1), dec64_new(17182818284590704, -16), "7182818284590704e-16 + 10e-1");
     test_add(dec64_new(4000000000000000, -16), dec64_new(10, -1), dec64_new(14000000000000000, -16), "4000000000000000e-16 + 10e-1");
     test_add(dec64_new(1, -1), dec64_new(2, -1), dec64_new(3, -1), "0.1 + 0.2");
+    test_add(dec64_new(35631689169707365, 15), dec64_new(92085672539766, 20), dec64_new(9244198943146307, 18), "scaled sum overflows");
+    test_add(dec64_new(-92085672539766, 20), dec64_new(-35631689169707365, 15), dec64_new(-9244198943146307, 18), "negative scaled sum overflows");
+    test_add(dec64_new(-9223372036854775, 3), dec64_new(-1499, 0), dec64_new(-9223372036854776, 3), "odd negative scaled sum overflows");
+    test_add(dec64_new(9223372036854775, 3), dec64_new(1499, 0), dec64_new(9223372036854776, 3), "odd positive scaled sum overflows");
 }
 
 static void test_all_ceiling() {
@@ -838,6 +874,7 @@ static void test_all_integer_divide() {
     test_integer_divide(maxnum, epsilon, nan, "maxnum / epsilon");
     test_integer_divide(maxint, epsilon, dec64_new(36028797018963967, 16), "maxint / epsilon");
     test_integer_divide(dec64_new(10, -1), maxint, zero, "one / maxint");
+    test_integer_divide(negative_maxint, negative_one, maxint_plus, "-maxint / -1");
 }
 
 static void test_all_is_equal() {
@@ -1449,6 +1486,42 @@ static void test_all_subtract() {
     test_subtract(maxnum, negative_maxint, maxnum, "maxnum - -maxint");
     test_subtract(maxnum, maxnum, zero, "maxnum - maxnum");
     test_subtract(almost_negative_one, almost_negative_one, zero, "almost_negative_one - almost_negative_one");
+    test_subtract(dec64_new(92233720368547, 5), negative_maxint, dec64_new(9259400833873664, 3), "scaled difference overflows");
+    test_subtract(dec64_new(-9223372036854775, 3), dec64_new(1499, 0), dec64_new(-9223372036854776, 3), "odd negative scaled difference overflows");
+    test_subtract(dec64_new(9223372036854775, 3), dec64_new(-1499, 0), dec64_new(9223372036854776, 3), "odd positive scaled difference overflows");
+}
+
+static void test_stats(int64 path, int64 expected, char* comment) {
+    judge_stats(expected, dec64_stats(path), "stats", comment);
+    dec64_stats_reset();
+}
+
+static void test_all_stats() {
+/*
+    Each operation is known to enter its slow path once. A build that counts
+    must count exactly that, and a build that does not must count nothing.
+*/
+    int64 path;
+
+    dec64_stats_reset();
+    for (path = 0; path < DEC64_STATS_NR_PATHS; path += 1) {
+        judge_stats(0, dec64_stats(path), "stats", "reset");
+    }
+    judge_stats(0, dec64_stats(-1), "stats", "path -1");
+    judge_stats(0, dec64_stats(DEC64_STATS_NR_PATHS), "stats", "no such path");
+    dec64_add(one, two);
+    test_stats(DEC64_STATS_ADD_SLOW, 0, "integers take the fast path");
+    dec64_add(one, cent);
+    judge_stats(0, dec64_stats(DEC64_STATS_ADD_OVERFLOW), "stats", "add_overflow");
+    judge_stats(COUNTED, dec64_stats(DEC64_STATS_ADD_SLOW), "stats", "add_slow");
+    test_stats(DEC64_STATS_ADD_SLOWER, COUNTED, "add_slower");
+    dec64_divide(one, maxint);
+    test_stats(DEC64_STATS_DIVIDE_PRESCALE, COUNTED, "divide_prescale");
+    dec64_add(dec64_new(9223372036854775, 3), one);
+    judge_stats(COUNTED, dec64_stats(DEC64_STATS_PACK_LARGE), "stats", "pack_large");
+    test_stats(DEC64_STATS_PACK_INCREASE, COUNTED, "pack_increase");
+    dec64_normal(dec64_new(1000000, -6));
+    test_stats(DEC64_STATS_NORMAL_DIVIDE, COUNTED, "normal_divide once, not per digit");
 }
 
 static int do_tests(int level_of_detail) {
@@ -1485,6 +1558,7 @@ static int do_tests(int level_of_detail) {
     test_all_round();
     test_all_signum();
     test_all_subtract();
+    test_all_stats();
 
     printf("\n\n%i pass, %i fail.\n", nr_pass, nr_fail);
     return nr_fail;
@@ -0,0 +1,53 @@
+@echo off
+rem dec64_test.cmd
+rem
+rem Assemble dec64.asm with ml64 in each configuration, and run dec64_test.c
+rem against each one that can run here. Run it from an x64 Native Tools Command
+rem Prompt, where ml64 and cl are on the path.
+rem
+rem     STATS 0 and 1, each with SYMBOLS 0 and 1: assembled and tested, with
+rem     DEC64_STATS defined for the test when STATS is 1
+rem     UNIX 1, with STATS 0 and 1: assembled only, because the Unix calling
+rem     convention cannot be called from a Windows program
+rem
+rem The exit status is 1 if any configuration fails to build or to pass.
+rem
+rem dec64.com
+rem 2026-10-19
+rem Public Domain
+rem
+rem No warranty.
+
+setlocal
+set "failed=0"
+
+for %%s in (0 1) do (
+    for %%y in (0 1) do call :test %%s %%y
+)
+for %%s in (0 1) do call :assemble "/DUNIX=1 /DSTATS=%%s" dec64_unix.obj
+
+if "%failed%"=="0" (
+    echo All configurations pass.
+) else (
+    echo FAIL
+)
+exit /b %failed%
+
+:test
+echo STATS=%1 SYMBOLS=%2
+call :assemble "/DSTATS=%1 /DSYMBOLS=%2" dec64.obj || exit /b 1
+set "stats="
+if "%1"=="1" set "stats=/DDEC64_STATS"
+cl /nologo /O2 %stats% dec64_test.c dec64.obj /Fedec64_test.exe || (
+    set "failed=1"
+    exit /b 1
+)
+dec64_test.exe || set "failed=1"
+exit /b 0
+
+:assemble
+ml64 /nologo /c %~1 /Fo%2 dec64.asm || (
+    set "failed=1"
+    exit /b 1
+)
+exit /b 0